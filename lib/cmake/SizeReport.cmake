@@ -0,0 +1,43 @@
+# Print a size summary of a shared library: the size of its sections, the number
+# of its relocations and its largest symbols.
+#
+# Usage: cmake -DLIBRARY=<file> -DSIZE=<size> -DNM=<nm> -DREADELF=<readelf> -P SizeReport.cmake
+
+set(TOP_SYMBOLS 25)
+
+execute_process(COMMAND ${SIZE} -A ${LIBRARY} OUTPUT_VARIABLE sections)
+message("${sections}")
+
+execute_process(COMMAND ${READELF} -r -W ${LIBRARY} OUTPUT_VARIABLE relocations)
+string(REGEX MATCHALL " R_[A-Z0-9_]+" relocations "${relocations}")
+list(LENGTH relocations relocationsCount)
+message("Relocations: ${relocationsCount}\n")
+
+# Symbols are scanned line by line since demangled names can contain list separators
+execute_process(COMMAND ${NM} -C -S -r --size-sort ${LIBRARY} OUTPUT_VARIABLE symbols ERROR_QUIET)
+if (symbols STREQUAL "")
+  # Stripped library, fall back to the dynamic symbols
+  execute_process(COMMAND ${NM} -D -C -S -r --size-sort ${LIBRARY} OUTPUT_VARIABLE symbols)
+endif()
+set(wrapperCount 0)
+set(wrapperSize 0)
+set(top "")
+set(index 0)
+string(FIND "${symbols}" "\n" end)
+while (end GREATER -1)
+  string(SUBSTRING "${symbols}" 0 ${end} line)
+  math(EXPR end "${end} + 1")
+  string(SUBSTRING "${symbols}" ${end} -1 symbols)
+  if (index LESS TOP_SYMBOLS)
+    set(top "${top}${line}\n")
+  endif()
+  if (line MATCHES "^[0-9a-f]+ ([0-9a-f]+) .*Wrapper")
+    math(EXPR wrapperCount "${wrapperCount} + 1")
+    math(EXPR wrapperSize "${wrapperSize} + 0x${CMAKE_MATCH_1}")
+  endif()
+  math(EXPR index "${index} + 1")
+  string(FIND "${symbols}" "\n" end)
+endwhile()
+
+message("Wrapper symbols: ${wrapperCount} (${wrapperSize} bytes)\n")
+message("Largest ${TOP_SYMBOLS} symbols:\n${top}")
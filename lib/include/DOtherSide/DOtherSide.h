@@ -33,7 +33,11 @@
 #define DOS_API   __declspec( dllexport )
 #define DOS_CALL __cdecl
 #else
+#if defined(__GNUC__)
+#define DOS_API __attribute__((visibility("default")))
+#else
 #define DOS_API
+#endif
 #define DOS_CALL
 #endif
 
@@ -141,12 +145,148 @@ DOS_API DosQQmlContext *DOS_CALL dos_qqmlapplicationengine_context(DosQQmlApplic
 /// \param vptr_i A QQuickImageProvider, the QQmlApplicationEngine takes ownership of this pointer
 DOS_API void DOS_CALL dos_qqmlapplicationengine_addImageProvider(DosQQmlApplicationEngine *vptr, const char* name, DosQQuickImageProvider *vptr_i);
 
+/// \brief Set the time spent each frame to incubate objects created by dos_qqmlcomponent_incubate()
+/// \param vptr The QQmlApplicationEngine
+/// \param msecs The milliseconds of incubation every 16 milliseconds. Zero removes the budget
+/// \note Without a budget incubation is driven by the QQuickWindow of the engine, if any, or is synchronous
+DOS_API void DOS_CALL dos_qqmlapplicationengine_set_incubation_budget(DosQQmlApplicationEngine *vptr, int msecs);
+
+/// \brief Compile QML files in the background ahead of their use
+/// \param vptr The QQmlApplicationEngine
+/// \param urls The QUrl of the files
+/// \param count The number of files
+/// \param callback Optional. Called on the GUI thread after each file has been compiled
+/// \param callbackData The data passed to the \p callback
+/// \note The files are compiled one at a time on the QML loader thread, reading and writing the QML disk
+/// cache when enabled. The compiled files stay in the engine type cache until the engine is deleted
+DOS_API void DOS_CALL dos_qqmlapplicationengine_preload(DosQQmlApplicationEngine *vptr, DosQUrl **urls, int count,
+                                                        DosQQmlPreloadCallback callback, void *callbackData);
+
 /// \brief Free the memory allocated for the given QQmlApplicationEngine
 /// \param vptr The QQmlApplicationEngine
 DOS_API void DOS_CALL dos_qqmlapplicationengine_delete(DosQQmlApplicationEngine *vptr);
 
 /// @}
 
+/// \defgroup QQmlComponent QQmlComponent
+/// \brief Functions related to the QQmlComponent class
+/// @{
+
+/// \brief Create a new QQmlComponent
+/// \param engine The QQmlApplicationEngine
+/// \param callback Optional. Called every time the status of the component changes
+/// \param callbackData The data passed to the \p callback
+/// \note The returned QQmlComponent should be freed by using dos_qqmlcomponent_delete()
+DOS_API DosQQmlComponent *DOS_CALL dos_qqmlcomponent_create(DosQQmlApplicationEngine *engine,
+                                                            DosQQmlComponentStatusCallback callback,
+                                                            void *callbackData);
+
+/// \brief Calls the QQmlComponent::loadUrl function
+/// \param vptr The QQmlComponent
+/// \param url The QUrl of the file to load
+/// \param asynchronous If true the QML is compiled on a background thread and the status
+/// callback reports when the component is ready
+DOS_API void DOS_CALL dos_qqmlcomponent_load_url(DosQQmlComponent *vptr, DosQUrl *url, bool asynchronous);
+
+/// \brief Calls the QQmlComponent::setData function
+/// \param vptr The QQmlComponent
+/// \param data The UTF-8 string of the QML to load
+/// \param url The QUrl used to resolve relative imports
+DOS_API void DOS_CALL dos_qqmlcomponent_set_data(DosQQmlComponent *vptr, const char *data, DosQUrl *url);
+
+/// \brief Return the DosQQmlComponentStatus of the QQmlComponent
+/// \param vptr The QQmlComponent
+DOS_API int DOS_CALL dos_qqmlcomponent_status(const DosQQmlComponent *vptr);
+
+/// \brief Calls the QQmlComponent::errorString function
+/// \param vptr The QQmlComponent
+/// \note The returned string should be freed by using the dos_chararray_delete() function
+DOS_API char *DOS_CALL dos_qqmlcomponent_error_string(const DosQQmlComponent *vptr);
+
+/// \brief Create synchronously an object of a ready QQmlComponent
+/// \param vptr The QQmlComponent
+/// \param context Optional. The QQmlContext of the object, the root context of the engine when null
+/// \return The object or nullptr if the creation failed
+/// \note The returned QObject should be freed by using dos_qobject_delete()
+DOS_API DosQObject *DOS_CALL dos_qqmlcomponent_create_object(DosQQmlComponent *vptr, DosQQmlContext *context);
+
+/// \brief Create an object of a ready QQmlComponent incrementally
+/// \param vptr The QQmlComponent
+/// \param context Optional. The QQmlContext of the object, the root context of the engine when null
+/// \param callback Called when the creation completes
+/// \param callbackData The data passed to the \p callback
+/// \note The object is created in slices within the budget given to dos_qqmlapplicationengine_set_incubation_budget()
+/// so that a heavy object doesn't block the frames. The \p callback can be called before this function returns
+/// \note The object passed to the \p callback should be freed by using dos_qobject_delete()
+/// \note The returned QQmlIncubator should be freed by using dos_qqmlincubator_delete() but not within the \p callback
+DOS_API DosQQmlIncubator *DOS_CALL dos_qqmlcomponent_incubate(DosQQmlComponent *vptr, DosQQmlContext *context,
+                                                              DosQQmlIncubatorCallback callback, void *callbackData);
+
+/// \brief Free the memory allocated for the given QQmlComponent
+/// \param vptr The QQmlComponent
+DOS_API void DOS_CALL dos_qqmlcomponent_delete(DosQQmlComponent *vptr);
+
+/// \brief Return the DosQQmlIncubatorStatus of the QQmlIncubator
+/// \param vptr The QQmlIncubator
+DOS_API int DOS_CALL dos_qqmlincubator_status(const DosQQmlIncubator *vptr);
+
+/// \brief Calls the QQmlIncubator::forceCompletion function
+/// \param vptr The QQmlIncubator
+/// \note The completion callback is called before this function returns
+DOS_API void DOS_CALL dos_qqmlincubator_force_completion(DosQQmlIncubator *vptr);
+
+/// \brief Free the memory allocated for the given QQmlIncubator
+/// \param vptr The QQmlIncubator
+/// \note An incomplete creation is aborted while a completed object is left alive
+DOS_API void DOS_CALL dos_qqmlincubator_delete(DosQQmlIncubator *vptr);
+
+/// @}
+
+/// \defgroup dos_qqmlcomponentpool DosQQmlComponentPool
+/// \brief Functions related to the DosQQmlComponentPool class
+/// @{
+
+/// \brief Create a pool of objects of a QQmlComponent
+/// \param component The QQmlComponent. It should outlive the pool
+/// \param context Optional. The QQmlContext of the objects, the root context of the engine when null
+/// \param capacity The maximum number of objects kept in the pool
+/// \param callback Optional. Called when an object is given back to the pool
+/// \param callbackData The data passed to the \p callback
+/// \note The returned DosQQmlComponentPool should be freed by using dos_qqmlcomponentpool_delete()
+DOS_API DosQQmlComponentPool *DOS_CALL dos_qqmlcomponentpool_create(DosQQmlComponent *component, DosQQmlContext *context,
+                                                                    int capacity,
+                                                                    DosQQmlComponentPoolRecycleCallback callback,
+                                                                    void *callbackData);
+
+/// \brief Create objects until the pool holds its capacity
+/// \param vptr The DosQQmlComponentPool
+/// \note The objects are incubated within the budget given to dos_qqmlapplicationengine_set_incubation_budget()
+DOS_API void DOS_CALL dos_qqmlcomponentpool_fill(DosQQmlComponentPool *vptr);
+
+/// \brief Take an object from the pool
+/// \param vptr The DosQQmlComponentPool
+/// \return A pooled object or a new one if the pool is empty, nullptr if the creation failed
+/// \note The returned QObject should be given back with dos_qqmlcomponentpool_release() or freed by
+/// using dos_qobject_delete()
+DOS_API DosQObject *DOS_CALL dos_qqmlcomponentpool_acquire(DosQQmlComponentPool *vptr);
+
+/// \brief Give back an object to the pool
+/// \param vptr The DosQQmlComponentPool
+/// \param object An object returned by dos_qqmlcomponentpool_acquire()
+/// \note The recycle callback is called and the object is detached from its parent and hidden.
+/// The object is deleted instead if the pool is full
+DOS_API void DOS_CALL dos_qqmlcomponentpool_release(DosQQmlComponentPool *vptr, DosQObject *object);
+
+/// \brief Return the number of objects ready in the pool
+/// \param vptr The DosQQmlComponentPool
+DOS_API int DOS_CALL dos_qqmlcomponentpool_available(const DosQQmlComponentPool *vptr);
+
+/// \brief Free the memory allocated for the given DosQQmlComponentPool and its objects
+/// \param vptr The DosQQmlComponentPool
+DOS_API void DOS_CALL dos_qqmlcomponentpool_delete(DosQQmlComponentPool *vptr);
+
+/// @}
+
 /// \defgroup QQuickImageProvider QQuickImageProvider
 /// \brief Functions related to the QQuickImageProvider class
 /// @{
@@ -260,6 +400,15 @@ DOS_API char *DOS_CALL dos_qqmlcontext_baseUrl(const DosQQmlContext *vptr);
 /// \param value The property value. The DosQVariant is owned by the caller thus it will not be deleted by the library
 DOS_API void DOS_CALL dos_qqmlcontext_setcontextproperty(DosQQmlContext *vptr, const char *name, DosQVariant *value);
 
+/// \brief Sets many properties inside the context with a single refresh of the bindings
+/// \param vptr The DosQQmlContext
+/// \param count The number of properties
+/// \param names The property names. The strings are owned by the caller thus they will not be deleted by the library
+/// \param values The property values. The DosQVariant are owned by the caller thus they will not be deleted by the library
+/// \note Prefer this function to many dos_qqmlcontext_setcontextproperty() calls since each of them
+/// refreshes the bindings depending on the context
+DOS_API void DOS_CALL dos_qqmlcontext_setcontextproperties(DosQQmlContext *vptr, int count, const char **names, DosQVariant **values);
+
 /// @}
 
 /// \defgroup String String
@@ -471,6 +620,8 @@ DOS_API DosQObject *DOS_CALL dos_qvariant_toQObject(const DosQVariant *vptr);
 /// \param slotDefinitions The SlotDefinitions struct
 /// \param propertyDefinitions The PropertyDefinitions struct
 /// \note The returned QMetaObject should be freed using dos_qmetaobject_delete().
+/// \note Calls with the same superclass, class name and definitions share the same QMetaObject
+/// while any of the returned ones is alive
 /// \attention The QMetaObject should live more than the QObject it refears to.
 /// Depending on the implementation usually the QMetaObject should be modeled as static variable
 /// So with a lifetime equals to the entire application
@@ -484,6 +635,48 @@ DOS_API DosQMetaObject *DOS_CALL dos_qmetaobject_create(DosQMetaObject *superCla
 /// \param vptr The QMetaObject
 DOS_API void DOS_CALL dos_qmetaobject_delete(DosQMetaObject *vptr);
 
+/// \brief Return the statistics of the QMetaObject cache of dos_qmetaobject_create()
+/// \param hits Filled with the number of calls that returned a shared QMetaObject
+/// \param misses Filled with the number of calls that created a new QMetaObject
+DOS_API void DOS_CALL dos_qmetaobject_cache_statistics(int *hits, int *misses);
+
+/// \brief Create many QMetaObjects in a single call
+/// \param count The number of descriptors
+/// \param descriptors The QMetaObject definitions
+/// \param result Filled with the \p count QMetaObjects in the order of \p descriptors
+/// \return True if every descriptor has a valid superclass
+/// \note Equal names are converted once for the whole batch and the QMetaObjects not depending
+/// on each other can be built in parallel. Prefer this function to many dos_qmetaobject_create() calls
+/// when defining a large number of classes
+/// \note Descriptors share the QMetaObject cache of dos_qmetaobject_create()
+/// \note The returned QMetaObjects should be freed using dos_qmetaobject_delete()
+DOS_API bool DOS_CALL dos_qmetaobject_create_batch(int count,
+                                                   const DosQMetaObjectDescriptor *descriptors,
+                                                   DosQMetaObject **result);
+
+/// \brief Serialize QMetaObjects in a binary table
+/// \param metaObjects The QMetaObjects created by dos_qmetaobject_create()
+/// \param count The number of QMetaObjects
+/// \param size Filled with the size in bytes of the table. Must not be null
+/// \return The table or nullptr if \p size is null or the superclass of a QMetaObject is neither a base one, like
+/// dos_qobject_qmetaobject(), nor a QMetaObject preceding it in \p metaObjects
+/// \note The returned table should be freed using dos_chararray_delete()
+/// \note The table can be loaded only by the same DOtherSide version built with the same Qt major version.
+/// It's meant to be generated at build time or cached on disk
+DOS_API char *DOS_CALL dos_qmetaobject_serialize(DosQMetaObject **metaObjects, int count, int *size);
+
+/// \brief Create the QMetaObjects of a table made by dos_qmetaobject_serialize()
+/// \param table The table
+/// \param size The size in bytes of the table
+/// \param count The number of QMetaObjects in the table
+/// \param result Filled with the \p count QMetaObjects in the order they were serialized
+/// \return True if the table is valid and it contains \p count QMetaObjects. Nothing is created otherwise
+/// \note The signatures are stored ready for use thus no definition is converted or formatted
+/// \note The QMetaObjects are never shared: they don't use the cache of dos_qmetaobject_create() and
+/// every call creates new ones, even for the same table
+/// \note The returned QMetaObjects should be freed using dos_qmetaobject_delete()
+DOS_API bool DOS_CALL dos_qmetaobject_create_many(const char *table, int size, int count, DosQMetaObject **result);
+
 /// \brief Invoke a function with the given data
 /// \param callback The callback that will be called
 /// \param data The data passed to the callback
@@ -649,6 +842,38 @@ DOS_API void DOS_CALL dos_qabstractitemmodel_beginRemoveColumns(DosQAbstractItem
 /// \param vptr The QAbstractItemModel
 DOS_API void DOS_CALL dos_qabstractitemmodel_endRemoveColumns(DosQAbstractItemModel *vptr);
 
+/// \brief Calls the QAbstractItemModel::beginMoveRows() function
+/// \param vptr The QAbstractItemModel
+/// \param sourceParent The parent QModelIndex of the moved rows
+/// \param first The first row in the range
+/// \param last The last row in the range
+/// \param destinationParent The parent QModelIndex of the destination
+/// \param destinationChild The row before which the rows are moved
+/// \return False if the move is invalid. In that case dos_qabstractitemmodel_endMoveRows \b shouldn't be called
+/// \note The \p sourceParent and \p destinationParent QModelIndex are owned by the caller thus they will not be deleted
+DOS_API bool DOS_CALL dos_qabstractitemmodel_beginMoveRows(DosQAbstractItemModel *vptr, DosQModelIndex *sourceParent, int first, int last,
+                                                          DosQModelIndex *destinationParent, int destinationChild);
+
+/// \brief Calls the QAbstractItemModel::endMoveRows() function
+/// \param vptr The QAbstractItemModel
+DOS_API void DOS_CALL dos_qabstractitemmodel_endMoveRows(DosQAbstractItemModel *vptr);
+
+/// \brief Calls the QAbstractItemModel::beginMoveColumns() function
+/// \param vptr The QAbstractItemModel
+/// \param sourceParent The parent QModelIndex of the moved columns
+/// \param first The first column in the range
+/// \param last The last column in the range
+/// \param destinationParent The parent QModelIndex of the destination
+/// \param destinationChild The column before which the columns are moved
+/// \return False if the move is invalid. In that case dos_qabstractitemmodel_endMoveColumns \b shouldn't be called
+/// \note The \p sourceParent and \p destinationParent QModelIndex are owned by the caller thus they will not be deleted
+DOS_API bool DOS_CALL dos_qabstractitemmodel_beginMoveColumns(DosQAbstractItemModel *vptr, DosQModelIndex *sourceParent, int first, int last,
+                                                             DosQModelIndex *destinationParent, int destinationChild);
+
+/// \brief Calls the QAbstractItemModel::endMoveColumns() function
+/// \param vptr The QAbstractItemModel
+DOS_API void DOS_CALL dos_qabstractitemmodel_endMoveColumns(DosQAbstractItemModel *vptr);
+
 /// \brief Calls the QAbstractItemModel::beginResetModel() function
 /// \param vptr The QAbstractItemModel
 DOS_API void DOS_CALL dos_qabstractitemmodel_beginResetModel(DosQAbstractItemModel *vptr);
@@ -673,6 +898,15 @@ DOS_API void DOS_CALL dos_qabstractitemmodel_dataChanged(DosQAbstractItemModel *
 DOS_API DosQModelIndex *DOS_CALL dos_qabstractitemmodel_createIndex(DosQAbstractItemModel *vptr,
                                                                     int row, int column, void *data);
 
+/// \brief Create an index value of the given model
+/// \param vptr The QAbstractItemModel
+/// \param row The index row
+/// \param column The index column
+/// \param internalId The index internal id
+/// \note Unlike dos_qabstractitemmodel_createIndex() nothing is allocated
+DOS_API DosModelIndexValue DOS_CALL dos_qabstractitemmodel_createIndexValue(DosQAbstractItemModel *vptr,
+                                                                           int row, int column, uintptr_t internalId);
+
 
 /// \brief Calls the default QAbstractItemModel::setData() function
 DOS_API bool DOS_CALL dos_qabstractitemmodel_setData(DosQAbstractItemModel *vptr,
@@ -689,6 +923,401 @@ DOS_API int DOS_CALL dos_qabstractitemmodel_flags(DosQAbstractItemModel *vptr,
 DOS_API DosQVariant *DOS_CALL dos_qabstractitemmodel_headerData(DosQAbstractItemModel *vptr,
                                                                 int section, int orientation, int role);
 
+/// \brief Notify that an asynchronous fetch of rows completed
+/// \param vptr The QAbstractItemModel
+/// \param parent The parent QModelIndex received by the fetchMore callback
+/// \param count The number of fetched rows
+/// \note This function is thread safe. Rows are inserted on the model thread in bounded chunks, one
+/// chunk per event loop iteration, each committed through the callback given to
+/// dos_qabstractitemmodel_setCommitFetchedRowsCallback(). canFetchMore()
+/// returns false for \p parent until all its rows are inserted
+/// \note The \p parent QModelIndex is owned by the caller thus it will not be deleted
+DOS_API void DOS_CALL dos_qabstractitemmodel_fetchComplete(DosQAbstractItemModel *vptr, const DosQModelIndex *parent, int count);
+
+/// \brief Queue a dataChanged signal for a cell of the root index
+/// \param vptr The QAbstractItemModel
+/// \param row The row of the changed cell
+/// \param column The column of the changed cell
+/// \param roles The changed roles. Can be nullptr for all the roles
+/// \param rolesCount The roles array length
+/// \note Queued cells are merged into rectangular ranges with the union of their roles and
+/// emitted once per event loop iteration, on dos_qabstractitemmodel_flushDataChanged() or before
+/// any rows or columns change. A model reset discards them
+/// \note The \p roles array is owned by the caller thus it will not be deleted
+DOS_API void DOS_CALL dos_qabstractitemmodel_queueDataChanged(DosQAbstractItemModel *vptr, int row, int column,
+                                                             const int *roles, int rolesCount);
+
+/// \brief Emit the dataChanged signals queued with dos_qabstractitemmodel_queueDataChanged()
+/// \param vptr The QAbstractItemModel
+DOS_API void DOS_CALL dos_qabstractitemmodel_flushDataChanged(DosQAbstractItemModel *vptr);
+
+/// \brief Set the optional callback prefetching the data of blocks of rows
+/// \param vptr The QAbstractItemModel
+/// \param callback The callback or nullptr for fetching each value through the data callback
+/// \note When set data() results are prefetched in blocks of rows and served from a cache until
+/// the next dataChanged, structural change or reset
+/// \note Item models whose indexes are created by the binding aren't prefetched, since creating the
+/// indexes of a block would call the binding once per row. It's used by list and table models and by
+/// item models with the native tree enabled
+DOS_API void DOS_CALL dos_qabstractitemmodel_setFetchRangeCallback(DosQAbstractItemModel *vptr, FetchRangeCallback callback);
+
+/// \brief Set the optional callback implementing QAbstractItemModel::moveRows()
+/// \param vptr The QAbstractItemModel
+/// \param callback The callback or nullptr for failing as in QAbstractItemModel
+DOS_API void DOS_CALL dos_qabstractitemmodel_setMoveRowsCallback(DosQAbstractItemModel *vptr, MoveRowsCallback callback);
+
+/// \brief Set the value based callbacks of the model
+/// \param vptr The QAbstractItemModel
+/// \param callbacks The callbacks. Unset ones fall back to the DosQAbstractItemModelCallbacks given at creation
+/// \note Value based callbacks receive the indexes as DosModelIndexValue thus nothing is allocated per call
+/// \note The \p callbacks struct is copied and owned by the caller thus it will not be deleted
+DOS_API void DOS_CALL dos_qabstractitemmodel_setValueCallbacks(DosQAbstractItemModel *vptr,
+                                                               const DosQAbstractItemModelValueCallbacks *callbacks);
+
+/// \brief Make fetchMore() asynchronous
+/// \param vptr The QAbstractItemModel
+/// \param callback The callback or nullptr for a synchronous fetchMore()
+/// \note When set the binding starts loading in the fetchMore callback, reports the loaded rows with
+/// dos_qabstractitemmodel_fetchComplete() and commits them when asked by \p callback
+DOS_API void DOS_CALL dos_qabstractitemmodel_setCommitFetchedRowsCallback(DosQAbstractItemModel *vptr, CommitFetchedRowsCallback callback);
+
+/// \brief Enable the caching of the data() results
+/// \param vptr The QAbstractItemModel
+/// \param bytes The memory budget in bytes. Pass 0 for disabling the cache
+/// \note Cached values are invalidated by dataChanged for the given rectangle and roles,
+/// shifted by rows and columns insertions and removals and cleared by a model reset
+DOS_API void DOS_CALL dos_qabstractitemmodel_setDataCacheBudget(DosQAbstractItemModel *vptr, int bytes);
+
+/// \brief Declare which model data is static
+/// \param vptr The QAbstractItemModel
+/// \param staticData A combination of DosQAbstractItemModelStaticData values. Pass 0 for
+/// requesting every value to the binding
+/// \note Static data is requested to the binding the first time it's needed and then
+/// served by the DOtherSide library until the corresponding invalidation call
+DOS_API void DOS_CALL dos_qabstractitemmodel_setStaticData(DosQAbstractItemModel *vptr, int staticData);
+
+/// \brief Drop the stored static role names
+/// \param vptr The QAbstractItemModel
+DOS_API void DOS_CALL dos_qabstractitemmodel_invalidateRoleNames(DosQAbstractItemModel *vptr);
+
+/// \brief Drop the stored static flags
+/// \param vptr The QAbstractItemModel
+DOS_API void DOS_CALL dos_qabstractitemmodel_invalidateFlags(DosQAbstractItemModel *vptr);
+
+/// \brief Drop the stored static header data and emit the QAbstractItemModel::headerDataChanged() signal
+/// \param vptr The QAbstractItemModel
+/// \param orientation The header orientation
+/// \param first The first changed section
+/// \param last The last changed section
+DOS_API void DOS_CALL dos_qabstractitemmodel_invalidateHeaderData(DosQAbstractItemModel *vptr, int orientation, int first, int last);
+
+/// \brief Update the rows of the root index to a new snapshot emitting granular change signals
+/// \param vptr The QAbstractItemModel
+/// \param keys The unique key of every row in the new order
+/// \param hashes The content hash of every row. Can be nullptr if changes of content shouldn't be detected
+/// \param count The number of rows
+/// \note The binding must already serve the new rows when this function is called. Removals, moves,
+/// insertions and content changes are emitted as if the model went through them one at a time.
+/// The children of the root rows move along with their parents.
+/// The first snapshot and duplicated keys result in a model reset
+DOS_API void DOS_CALL dos_qabstractitemmodel_applySnapshot(DosQAbstractItemModel *vptr,
+                                                          const unsigned long long *keys,
+                                                          const unsigned long long *hashes,
+                                                          int count);
+
+/// \brief Serve the model structure from a native node tree
+/// \param vptr The QAbstractItemModel
+/// \param columnCount The number of columns of every node
+/// \note Once enabled, index(), parent(), rowCount(), columnCount() and hasChildren() never call
+/// the binded language. The internal id of an index is the payload of its node, so the data
+/// callbacks identify nodes with dos_qmodelindex_internalPointer(). The model is reset
+DOS_API void DOS_CALL dos_qabstractitemmodel_enableTree(DosQAbstractItemModel *vptr, int columnCount);
+
+/// \brief Insert nodes in the native node tree
+/// \param vptr The QAbstractItemModel
+/// \param parent The parent index
+/// \param row The row before which the nodes are inserted
+/// \param payloads The payloads of the new nodes. Payloads must be unique in the tree
+/// \param count The number of nodes
+/// \return True if the nodes have been inserted
+/// \note The rowsAboutToBeInserted and rowsInserted signals are emitted
+DOS_API bool DOS_CALL dos_qabstractitemmodel_treeInsert(DosQAbstractItemModel *vptr, const DosQModelIndex *parent,
+                                                        int row, const uintptr_t *payloads, int count);
+
+/// \brief Remove nodes and their descendants from the native node tree
+/// \param vptr The QAbstractItemModel
+/// \param parent The parent index
+/// \param row The first removed row
+/// \param count The number of removed rows
+/// \return True if the nodes have been removed
+/// \note The rowsAboutToBeRemoved and rowsRemoved signals are emitted
+DOS_API bool DOS_CALL dos_qabstractitemmodel_treeRemove(DosQAbstractItemModel *vptr, const DosQModelIndex *parent,
+                                                        int row, int count);
+
+/// \brief Return the index of the native tree node with the given payload
+/// \param vptr The QAbstractItemModel
+/// \param payload The node payload
+/// \param column The index column
+/// \return The index, invalid if no node has the given payload
+/// \note The returned QModelIndex should be freed by calling the dos_qmodelindex_delete() function
+DOS_API DosQModelIndex *DOS_CALL dos_qabstractitemmodel_treeIndex(DosQAbstractItemModel *vptr, uintptr_t payload, int column);
+
+/// \brief Remove all the nodes of the native node tree
+/// \param vptr The QAbstractItemModel
+/// \note The model is reset
+DOS_API void DOS_CALL dos_qabstractitemmodel_treeClear(DosQAbstractItemModel *vptr);
+
+/// @}
+
+/// \defgroup DosQColumnarModel DosQColumnarModel
+/// \brief Functions related to the DosQColumnarModel class
+/// A DosQColumnarModel is a QAbstractListModel whose data is stored in C++ typed buffers,
+/// one for each role, thus data() never calls the binded language
+/// @{
+
+/// \brief Create a new DosQColumnarModel
+/// \param callbackObject The pointer of the model in the binded language
+/// \param metaObject The QMetaObject for this model. It should inherit from dos_qabstractlistmodel_qmetaobject()
+/// \param dObjectCallback The callback for handling the properties read/write and slots execution
+/// \param roleCount The number of roles
+/// \param roleTypes The metatype of each role. Supported metatypes are QMetaType::Bool (bool),
+/// QMetaType::Int (int), QMetaType::LongLong (long long), QMetaType::Float (float),
+/// QMetaType::Double (double) and QMetaType::QString (UTF-8 encoded const char *)
+/// \param roleNames The name of each role
+/// \return The new model or nullptr if a role type is not supported
+/// \note The i-th role has id Qt::UserRole + 1 + i. Qt::DisplayRole is an alias of the first role
+/// \note The returned model can be used as DosQAbstractListModel and should be freed using dos_qobject_delete()
+DOS_API DosQColumnarModel *DOS_CALL dos_qcolumnarmodel_create(void *callbackObject,
+                                                              DosQMetaObject *metaObject,
+                                                              DObjectCallback dObjectCallback,
+                                                              int roleCount,
+                                                              const int *roleTypes,
+                                                              const char **roleNames);
+
+/// \brief Append rows
+/// \param vptr The DosQColumnarModel
+/// \param count The number of rows to append
+/// \param columns An array of one C array of \p count values for each role. A null array appends default values
+/// \return True if the rows have been appended
+/// \note The \p columns are owned by the caller and copied
+DOS_API bool DOS_CALL dos_qcolumnarmodel_append(DosQColumnarModel *vptr, int count, const void **columns);
+
+/// \brief Replace the values of a range of rows
+/// \param vptr The DosQColumnarModel
+/// \param row The first row in the range
+/// \param count The number of rows in the range
+/// \param columns An array of one C array of \p count values for each role. A null array leaves the role untouched
+/// \return True if the rows have been updated
+/// \note A single dataChanged signal is emitted for the updated roles
+DOS_API bool DOS_CALL dos_qcolumnarmodel_update_range(DosQColumnarModel *vptr, int row, int count, const void **columns);
+
+/// \brief Remove a range of rows
+/// \param vptr The DosQColumnarModel
+/// \param row The first row in the range
+/// \param count The number of rows in the range
+/// \return True if the rows have been removed
+DOS_API bool DOS_CALL dos_qcolumnarmodel_remove_range(DosQColumnarModel *vptr, int row, int count);
+
+/// \brief Remove all the rows
+/// \param vptr The DosQColumnarModel
+DOS_API void DOS_CALL dos_qcolumnarmodel_clear(DosQColumnarModel *vptr);
+
+/// \brief Record the insertion of rows in the journal
+/// \param vptr The DosQColumnarModel
+/// \param row The row before which the rows are inserted
+/// \param count The number of rows to insert
+/// \param columns An array of one C array of \p count values for each role. A null array inserts default values
+/// \note This function is thread safe. The \p columns are owned by the caller and copied
+/// \note The journal is replayed on the next frame of the model thread. Insertions of adjacent rows are
+/// signaled by a single rowsInserted and out of range insertions are ignored
+DOS_API void DOS_CALL dos_qcolumnarmodel_journal_insert(DosQColumnarModel *vptr, int row, int count, const void **columns);
+
+/// \brief Record the replacement of the values of a range of rows in the journal
+/// \param vptr The DosQColumnarModel
+/// \param row The first row in the range
+/// \param count The number of rows in the range
+/// \param columns An array of one C array of \p count values for each role. A null array leaves the role untouched
+/// \note This function is thread safe. Updates of overlapping rows are signaled by a single dataChanged
+DOS_API void DOS_CALL dos_qcolumnarmodel_journal_update(DosQColumnarModel *vptr, int row, int count, const void **columns);
+
+/// \brief Record the removal of a range of rows in the journal
+/// \param vptr The DosQColumnarModel
+/// \param row The first row in the range
+/// \param count The number of rows in the range
+/// \note This function is thread safe. Removals of adjacent rows are signaled by a single rowsRemoved
+DOS_API void DOS_CALL dos_qcolumnarmodel_journal_remove(DosQColumnarModel *vptr, int row, int count);
+
+/// \brief Record the move of a range of rows in the journal
+/// \param vptr The DosQColumnarModel
+/// \param row The first row in the range
+/// \param count The number of rows in the range
+/// \param destination The row before which the rows are moved, counted before the move
+/// \note This function is thread safe
+DOS_API void DOS_CALL dos_qcolumnarmodel_journal_move(DosQColumnarModel *vptr, int row, int count, int destination);
+
+/// \brief Replay the journal right away instead of waiting for the next frame
+/// \param vptr The DosQColumnarModel
+/// \note This function must be called from the model thread
+DOS_API void DOS_CALL dos_qcolumnarmodel_journal_replay(DosQColumnarModel *vptr);
+
+/// @}
+
+/// \defgroup DosQRingBufferModel DosQRingBufferModel
+/// \brief Functions related to the DosQRingBufferModel class
+/// A DosQRingBufferModel is an append only QAbstractListModel that keeps the last rows up to a fixed
+/// capacity in preallocated C++ typed buffers. Rows can be appended from any thread and are published
+/// once per frame, evicting the oldest rows
+/// @{
+
+/// \brief Create a new DosQRingBufferModel
+/// \param callbackObject The pointer of the model in the binded language
+/// \param metaObject The QMetaObject associated to the model
+/// \param dObjectCallback The callback called from QML whenever a slot or property should be in read, write or invoked
+/// \param capacity The maximum number of rows
+/// \param roleCount The number of roles
+/// \param roleTypes The QMetaType::Type of each role. Supported types are the same of dos_qcolumnarmodel_create()
+/// \param roleNames The name of each role
+/// \return A new DosQRingBufferModel or a null pointer if the capacity or a role type is not valid
+/// \note The roles ids start from Qt::UserRole + 1 and Qt::DisplayRole is an alias of the first role
+/// \note The returned DosQRingBufferModel should be freed by calling dos_qobject_delete()
+DOS_API DosQRingBufferModel *DOS_CALL dos_qringbuffermodel_create(void *callbackObject,
+                                                                  DosQMetaObject *metaObject,
+                                                                  DObjectCallback dObjectCallback,
+                                                                  int capacity,
+                                                                  int roleCount,
+                                                                  const int *roleTypes,
+                                                                  const char **roleNames);
+
+/// \brief Append rows
+/// \param vptr The DosQRingBufferModel
+/// \param count The number of rows to append
+/// \param columns An array of one C array of \p count values for each role. A null array appends default values
+/// \note The \p columns are owned by the caller and copied. This function can be called from any thread.
+/// The rows are published by a single insertion, preceded by a single removal of the evicted rows,
+/// on the next frame of the model thread
+DOS_API void DOS_CALL dos_qringbuffermodel_append(DosQRingBufferModel *vptr, int count, const void **columns);
+
+/// \brief Publish the appended rows immediately
+/// \param vptr The DosQRingBufferModel
+/// \note This function must be called from the model thread
+DOS_API void DOS_CALL dos_qringbuffermodel_flush(DosQRingBufferModel *vptr);
+
+/// \brief Remove all the rows, including the ones not yet published
+/// \param vptr The DosQRingBufferModel
+/// \note This function must be called from the model thread
+DOS_API void DOS_CALL dos_qringbuffermodel_clear(DosQRingBufferModel *vptr);
+
+/// @}
+
+/// \defgroup DosQMappedFileModel DosQMappedFileModel
+/// \brief Functions related to the DosQMappedFileModel class
+/// A DosQMappedFileModel is a read only QAbstractListModel whose rows are the records of a memory
+/// mapped file. Fields are decoded from the mapping only when data() is called, so opening is
+/// immediate and the memory usage doesn't depend on the file size
+/// @{
+
+/// \brief Create a new DosQMappedFileModel
+/// \param callbackObject The pointer of the model in the binded language
+/// \param metaObject The QMetaObject associated to the model
+/// \param dObjectCallback The callback called from QML whenever a slot or property should be in read, write or invoked
+/// \param dataPath The path of the file containing the records
+/// \param indexPath The path of a file of 64 bit little endian offsets of the records in the data file.
+/// A null pointer means that records have a fixed size
+/// \param headerSize The number of bytes preceding the first fixed size record
+/// \param recordSize The size of the fixed size records. Ignored if \p indexPath is given
+/// \param fieldCount The number of fields
+/// \param fields The definition of each field. Each field is exposed as a role
+/// \return A new DosQMappedFileModel or a null pointer if the files can't be opened or the layout is invalid
+/// \note The roles ids start from Qt::UserRole + 1 and Qt::DisplayRole is an alias of the first role
+/// \note A variable size record ends where the next one begins, the last one at the end of the data file
+/// \note The returned DosQMappedFileModel should be freed by calling dos_qobject_delete()
+DOS_API DosQMappedFileModel *DOS_CALL dos_qmappedfilemodel_create(void *callbackObject,
+                                                                  DosQMetaObject *metaObject,
+                                                                  DObjectCallback dObjectCallback,
+                                                                  const char *dataPath,
+                                                                  const char *indexPath,
+                                                                  int headerSize,
+                                                                  int recordSize,
+                                                                  int fieldCount,
+                                                                  const DosMappedFieldDefinition *fields);
+
+/// \brief Map the files again after they grew and insert the new records
+/// \param vptr The DosQMappedFileModel
+/// \return True if the files are mapped
+/// \note The files must only be appended to. Truncated files reset the model
+DOS_API bool DOS_CALL dos_qmappedfilemodel_refresh(DosQMappedFileModel *vptr);
+
+/// @}
+
+/// \defgroup DosQSortFilterProxyModel DosQSortFilterProxyModel
+/// \brief Functions related to the DosQSortFilterProxyModel class
+/// A DosQSortFilterProxyModel is a QSortFilterProxyModel that snapshots the sort and filter
+/// role values of the source model, thus comparisons and filtering never call the binded language.
+/// Large snapshots are sorted and filtered in parallel
+/// @{
+
+/// \brief Create a new DosQSortFilterProxyModel
+/// \return A new DosQSortFilterProxyModel
+/// \note The returned DosQSortFilterProxyModel should be freed by calling dos_qobject_delete()
+DOS_API DosQSortFilterProxyModel *DOS_CALL dos_qsortfilterproxymodel_create(void);
+
+/// \brief Set the source model
+/// \param vptr The DosQSortFilterProxyModel
+/// \param sourceModel The source QAbstractItemModel or a null pointer
+/// \note The source model is not owned by the proxy
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_setSourceModel(DosQSortFilterProxyModel *vptr, DosQAbstractItemModel *sourceModel);
+
+/// \brief Set the role whose values are compared when sorting
+/// \param vptr The DosQSortFilterProxyModel
+/// \param role The role
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_setSortRole(DosQSortFilterProxyModel *vptr, int role);
+
+/// \brief Sort the model
+/// \param vptr The DosQSortFilterProxyModel
+/// \param column The source column to sort on or -1 for the source order
+/// \param order The Qt::SortOrder
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_sort(DosQSortFilterProxyModel *vptr, int column, int order);
+
+/// \brief Set whether the proxy sorts and filters again when the source model changes
+/// \param vptr The DosQSortFilterProxyModel
+/// \param enable True for enabling the dynamic sort and filter
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_setDynamicSortFilter(DosQSortFilterProxyModel *vptr, bool enable);
+
+/// \brief Set the role whose values are matched when filtering
+/// \param vptr The DosQSortFilterProxyModel
+/// \param role The role
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_setFilterRole(DosQSortFilterProxyModel *vptr, int role);
+
+/// \brief Set the source column whose values are matched when filtering
+/// \param vptr The DosQSortFilterProxyModel
+/// \param column The column
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_setFilterKeyColumn(DosQSortFilterProxyModel *vptr, int column);
+
+/// \brief Set whether filtering is case sensitive
+/// \param vptr The DosQSortFilterProxyModel
+/// \param caseSensitive True for a case sensitive filter
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_setFilterCaseSensitive(DosQSortFilterProxyModel *vptr, bool caseSensitive);
+
+/// \brief Accept only the rows whose filter role value contains the given string
+/// \param vptr The DosQSortFilterProxyModel
+/// \param filter The UTF-8 string to match. A null pointer removes the filter
+/// \note When the new string contains the previous one only the rows accepted so far are matched again
+DOS_API void DOS_CALL dos_qsortfilterproxymodel_setFilterFixedString(DosQSortFilterProxyModel *vptr, const char *filter);
+
+/// \brief Map an index of the proxy to the source model
+/// \param vptr The DosQSortFilterProxyModel
+/// \param proxyIndex The proxy index
+/// \return The source index
+/// \note The returned QModelIndex should be freed by calling the dos_qmodelindex_delete() function
+DOS_API DosQModelIndex *DOS_CALL dos_qsortfilterproxymodel_mapToSource(DosQSortFilterProxyModel *vptr, const DosQModelIndex *proxyIndex);
+
+/// \brief Map an index of the source model to the proxy
+/// \param vptr The DosQSortFilterProxyModel
+/// \param sourceIndex The source index
+/// \return The proxy index. The index is invalid if the source row is filtered out
+/// \note The returned QModelIndex should be freed by calling the dos_qmodelindex_delete() function
+DOS_API DosQModelIndex *DOS_CALL dos_qsortfilterproxymodel_mapFromSource(DosQSortFilterProxyModel *vptr, const DosQModelIndex *sourceIndex);
+
 /// @}
 
 
@@ -874,6 +1503,46 @@ DOS_API void DOS_CALL dos_qmodelindex_assign(DosQModelIndex *l, const DosQModelI
 /// \return The internal pointer
 DOS_API void* DOS_CALL dos_qmodelindex_internalPointer(DosQModelIndex *vptr);
 
+/// \brief Return the value representation of a QModelIndex
+/// \param vptr The QModelIndex
+DOS_API DosModelIndexValue DOS_CALL dos_qmodelindex_to_value(const DosQModelIndex *vptr);
+
+/// \brief Assign an index value to a QModelIndex
+/// \param l The left side QModelIndex
+/// \param r The right side index value
+/// \note This can be used for filling the result of the index and parent callbacks without allocations
+DOS_API void DOS_CALL dos_qmodelindex_assign_value(DosQModelIndex *l, DosModelIndexValue r);
+
+/// \brief Return true if the index value is valid
+/// \param index The index value
+DOS_API bool DOS_CALL dos_qmodelindex_value_isValid(DosModelIndexValue index);
+
+/// \brief Calls the QModelIndex::data() function on an index value
+/// \param index The index value
+/// \param role The model role to which we want the data
+/// \return The QVariant associated at the given role
+/// \note The returned QVariant should be freed by calling the dos_qvariant_delete() function
+DOS_API DosQVariant *DOS_CALL dos_qmodelindex_value_data(DosModelIndexValue index, int role);
+
+/// \brief Calls the QModelIndex::parent() function on an index value
+/// \param index The index value
+/// \return The parent index value
+DOS_API DosModelIndexValue DOS_CALL dos_qmodelindex_value_parent(DosModelIndexValue index);
+
+/// \brief Return the child of an index value
+/// \param index The index value
+/// \param row The child row
+/// \param column The child column
+/// \return The child index value at the given \p row and \p column
+DOS_API DosModelIndexValue DOS_CALL dos_qmodelindex_value_child(DosModelIndexValue index, int row, int column);
+
+/// \brief Calls the QModelIndex::sibling() function on an index value
+/// \param index The index value
+/// \param row The sibling row
+/// \param column The sibling column
+/// \return The sibling index value at the given \p row and \p column
+DOS_API DosModelIndexValue DOS_CALL dos_qmodelindex_value_sibling(DosModelIndexValue index, int row, int column);
+
 
 /// @}
 
@@ -949,15 +1618,32 @@ DOS_API bool DOS_CALL dos_qurl_isValid(const DosQUrl *vptr);
 
 /// \brief Register a type in order to be instantiable from QML
 /// \return An integer value that represents the registration ID in the
-/// qml environment
+/// qml environment or -1 if the registration failed
+/// \note With Qt5 at most 256 types and singleton types can be registered in total, further
+/// registrations fail and return -1. With Qt6 the number of registrations is unlimited
 /// \note The \p qmlRegisterType is owned by the caller thus it will not be freed
 DOS_API int DOS_CALL dos_qdeclarative_qmlregistertype(const QmlRegisterType *qmlRegisterType);
 
 /// \brief Register a singleton type in order to be accessible from QML
 /// \return An integer value that represents the registration ID in the
+/// \note Registrations count against the Qt5 limit of dos_qdeclarative_qmlregistertype()
 /// \note The \p qmlRegisterType is owned by the caller thus it will not be freed
 DOS_API int DOS_CALL dos_qdeclarative_qmlregistersingletontype(const QmlRegisterType *qmlRegisterType);
 
+/// \brief Register a singleton type choosing when it's prepared and created
+/// \param qmlRegisterType The type to register
+/// \param mode The DosQmlSingletonMode
+/// \param prepareDObject Optional. Called once before the first CreateDObject callback of the type
+/// \return An integer value that represents the registration ID in the qml environment or -1
+/// if \p mode is not a DosQmlSingletonMode
+/// \note With DosQmlSingletonModePreloaded \p prepareDObject may be called before this function returns
+/// \note The object created by DosQmlSingletonModeEager is given to the first engine using the type, other
+/// engines create their own. If no engine took it, it's deleted when the application quits or is deleted
+/// \note The \p qmlRegisterType is owned by the caller thus it will not be freed
+DOS_API int DOS_CALL dos_qdeclarative_qmlregistersingletontype_with_mode(const QmlRegisterType *qmlRegisterType,
+                                                                         int mode,
+                                                                         PrepareDObject prepareDObject);
+
 /// @}
 
 
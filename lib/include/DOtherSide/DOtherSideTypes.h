@@ -35,6 +35,8 @@
 #define DOS_CALL
 #endif
 
+#include <stdint.h>
+
 #ifndef __cplusplus
 #include <stdbool.h>
 #endif
@@ -59,12 +61,33 @@ typedef void DosQAbstractListModel;
 /// A pointer to a QAbstractTableModel
 typedef void DosQAbstractTableModel;
 
+/// A pointer to a DosQColumnarModel
+typedef void DosQColumnarModel;
+
+/// A pointer to a DosQRingBufferModel
+typedef void DosQRingBufferModel;
+
+/// A pointer to a DosQMappedFileModel
+typedef void DosQMappedFileModel;
+
+/// A pointer to a DosQSortFilterProxyModel
+typedef void DosQSortFilterProxyModel;
+
 /// A pointer to a QQmlApplicationEngine
 typedef void DosQQmlApplicationEngine;
 
 /// A pointer to a QQuickView
 typedef void DosQQuickView;
 
+/// A pointer to a QQmlComponent
+typedef void DosQQmlComponent;
+
+/// A pointer to a QQmlIncubator
+typedef void DosQQmlIncubator;
+
+/// A pointer to a DosQQmlComponentPool
+typedef void DosQQmlComponentPool;
+
 /// A pointer to a QQmlContext
 typedef void DosQQmlContext;
 
@@ -116,6 +139,23 @@ typedef void (DOS_CALL *RequestPixmapCallback)(const char *id, int *width, int *
 /// \note The \p argv array is owned by the library thus it \b shouldn't be deleted
 typedef void (DOS_CALL *DObjectCallback)(void *self, DosQVariant *slotName, int argc, DosQVariant **argv);
 
+/// A QModelIndex passed by value
+/// \note An index value with a null \p model or negative \p row and \p column is invalid
+struct DosModelIndexValue {
+    /// The index row
+    int row;
+    /// The index column
+    int column;
+    /// The index internal id. Internal pointers are stored as their address
+    uintptr_t internalId;
+    /// The model that owns the index
+    DosQAbstractItemModel *model;
+};
+
+#ifndef __cplusplus
+typedef struct DosModelIndexValue DosModelIndexValue;
+#endif
+
 /// Called when the QAbstractItemModel::rowCount method must be executed
 /// \param self The pointer of the QAbstractItemModel in the binded language
 /// \param index The parent DosQModelIndex
@@ -158,6 +198,48 @@ typedef void (DOS_CALL *IndexCallback)(void *self, int row, int column, const Do
 /// Called when the QAbstractItemModel::parent method must be called
 typedef void (DOS_CALL *ParentCallback)(void *self, const DosQModelIndex *child, DosQModelIndex *result);
 
+/// Called when the QAbstractItemModel::index method must be called
+/// \note Value based variant of IndexCallback. The \p result should be filled, for example with
+/// dos_qabstractitemmodel_createIndexValue(), or left untouched for returning an invalid index
+typedef void (DOS_CALL *IndexValueCallback)(void *self, int row, int column, DosModelIndexValue parent, DosModelIndexValue *result);
+
+/// Called when the QAbstractItemModel::parent method must be called
+/// \note Value based variant of ParentCallback. The \p result should be filled, for example with
+/// dos_qabstractitemmodel_createIndexValue(), or left untouched for returning an invalid index
+typedef void (DOS_CALL *ParentValueCallback)(void *self, DosModelIndexValue child, DosModelIndexValue *result);
+
+/// Called when the QAbstractItemModel::rowCount method must be executed
+/// \note Value based variant of RowCountCallback
+typedef void (DOS_CALL *RowCountValueCallback)(void *self, DosModelIndexValue parent, int *result);
+
+/// Called when the QAbstractItemModel::columnCount method must be executed
+/// \note Value based variant of ColumnCountCallback
+typedef void (DOS_CALL *ColumnCountValueCallback)(void *self, DosModelIndexValue parent, int *result);
+
+/// Called when the QAbstractItemModel::data method must be executed
+/// \note Value based variant of DataCallback
+typedef void (DOS_CALL *DataValueCallback)(void *self, DosModelIndexValue index, int role, DosQVariant *result);
+
+/// Called when the QAbstractItemModel::setData method must be executed
+/// \note Value based variant of SetDataCallback
+typedef void (DOS_CALL *SetDataValueCallback)(void *self, DosModelIndexValue index, const DosQVariant *value, int role, bool *result);
+
+/// Called when the QAbstractItemModel::flags method must be called
+/// \note Value based variant of FlagsCallback
+typedef void (DOS_CALL *FlagsValueCallback)(void *self, DosModelIndexValue index, int *result);
+
+/// Called when the QAbstractItemModel::hasChildren method must be called
+/// \note Value based variant of HasChildrenCallback
+typedef void (DOS_CALL *HasChildrenValueCallback)(void *self, DosModelIndexValue parent, bool *result);
+
+/// Called when the QAbstractItemModel::canFetchMore method must be called
+/// \note Value based variant of CanFetchMoreCallback
+typedef void (DOS_CALL *CanFetchMoreValueCallback)(void *self, DosModelIndexValue parent, bool *result);
+
+/// Called when the QAbstractItemModel::fetchMore method must be called
+/// \note Value based variant of FetchMoreCallback
+typedef void (DOS_CALL *FetchMoreValueCallback)(void *self, DosModelIndexValue parent);
+
 /// Called when the QAbstractItemModel::hasChildren method must be called
 typedef void (DOS_CALL *HasChildrenCallback)(void *self, const DosQModelIndex *parent, bool *result);
 
@@ -167,6 +249,37 @@ typedef void (DOS_CALL *CanFetchMoreCallback)(void *self, const DosQModelIndex *
 /// Called when the QAbstractItemModel::fetchMore method must be called
 typedef void (DOS_CALL *FetchMoreCallback)(void *self, const DosQModelIndex *parent);
 
+/// Called when rows fetched asynchronously must become part of the model
+/// \param self The pointer of the QAbstractItemModel in the binded language
+/// \param parent The parent DosQModelIndex
+/// \param count The number of fetched rows that must be appended to the children of \p parent
+/// \note It's called on the model thread between the begin and the end of the rows insertion
+/// \note The \p parent QModelIndex is owned by the DOtherSide library thus it \b shouldn't be deleted
+typedef void (DOS_CALL *CommitFetchedRowsCallback)(void *self, const DosQModelIndex *parent, int count);
+
+/// Called when the data of a block of rows must be prefetched
+/// \param self The pointer to the QAbstractItemModel in the binded language
+/// \param parent The parent DosQModelIndex of the requested rows
+/// \param column The column of the requested rows
+/// \param firstRow The first requested row
+/// \param lastRow The last requested row (inclusive)
+/// \param roles The requested roles
+/// \param rolesCount The number of requested roles
+/// \param[out] result An array of (lastRow - firstRow + 1) * rolesCount DosQVariant to be filled
+/// from the binded language. The value for the i-th row and the j-th role is at position
+/// (i - firstRow) * rolesCount + j
+/// \note The \p parent, \p roles and \p result args are owned by the DOtherSide library thus they \b shouldn't be deleted
+/// \note Values left untouched are considered as empty QVariant
+typedef void (DOS_CALL *FetchRangeCallback)(void *self, const DosQModelIndex *parent, int column, int firstRow, int lastRow,
+                                            const int *roles, int rolesCount, DosQVariant **result);
+
+/// Called when the QAbstractItemModel::moveRows method must be called
+/// \note The \p sourceParent and \p destinationParent args are owned by the DOtherSide library thus they \b shouldn't be deleted
+/// \note The binding should move its rows between dos_qabstractitemmodel_beginMoveRows and
+/// dos_qabstractitemmodel_endMoveRows and set \p result to true on success
+typedef void (DOS_CALL *MoveRowsCallback)(void *self, const DosQModelIndex *sourceParent, int sourceRow, int count,
+                                          const DosQModelIndex *destinationParent, int destinationChild, bool *result);
+
 /// Callback called from QML for creating a registered type
 /**
  * When a type is created through the QML engine a new QObject \p "Wrapper" is created. This becomes a proxy
@@ -219,12 +332,43 @@ typedef void (DOS_CALL *CreateDObject)(int id, void *wrapper, void **bindedQObje
  */
 typedef void (DOS_CALL *DeleteDObject)(int id, void *bindedQObject);
 
+/// Callback invoked before the first creation of a singleton type
+/**
+ * This lets the binded language build the state of a heavy singleton ahead of time so that
+ * the following CreateDObject callback only has to attach it to the wrapper.
+ * Depending on the DosQmlSingletonMode this is called on a worker thread
+ * \param id This is the type id returned by dos_qdeclarative_qmlregistersingletontype_with_mode()
+ */
+typedef void (DOS_CALL *PrepareDObject)(int id);
+
 /// Callback invoked after an emit of a signal
 typedef void (DOS_CALL *DosQObjectConnectLambdaCallback)(void* callbackData, int argc, DosQVariant **argv);
 
 /// Callback invoked after a QMetaObject invoke method
 typedef void (DOS_CALL *DosQMetaObjectInvokeMethodCallback)(void* callbackData);
 
+/// Called when the status of a QQmlComponent changes
+/// \param callbackData The data given with the callback
+/// \param status The new DosQQmlComponentStatus
+typedef void (DOS_CALL *DosQQmlComponentStatusCallback)(void *callbackData, int status);
+
+/// Called when a QQmlIncubator completes
+/// \param callbackData The data given with the callback
+/// \param object The created QObject or nullptr if the creation failed
+typedef void (DOS_CALL *DosQQmlIncubatorCallback)(void *callbackData, DosQObject *object);
+
+/// Called when a file given to dos_qqmlapplicationengine_preload() has been compiled
+/// \param callbackData The data given with the callback
+/// \param index The index of the file
+/// \param status The DosQQmlComponentStatus of the file, Ready or Error
+/// \param milliseconds The time spent loading and compiling the file
+typedef void (DOS_CALL *DosQQmlPreloadCallback)(void *callbackData, int index, int status, double milliseconds);
+
+/// Called when an object is given back to a DosQQmlComponentPool
+/// \param callbackData The data given with the callback
+/// \param object The released QObject. The binding should reset its state so that it can be handed out again
+typedef void (DOS_CALL *DosQQmlComponentPoolRecycleCallback)(void *callbackData, DosQObject *object);
+
 /// \brief Store an array of QVariant
 /// \note This struct should be freed by calling dos_qvariantarray_delete(DosQVariantArray *ptr). This in turn
 /// cleans up the internal array
@@ -366,6 +510,28 @@ struct PropertyDefinitions {
 typedef struct PropertyDefinitions PropertyDefinitions;
 #endif
 
+/// Represents the definition of a QMetaObject created by dos_qmetaobject_create_batch()
+struct DosQMetaObjectDescriptor {
+    /// \brief The superclass QMetaObject
+    /// \note Ignored when superClassIndex is not negative
+    DosQMetaObject *superClassMetaObject;
+    /// \brief The index of the superclass descriptor in the same batch or -1
+    /// \note The superclass descriptor must precede this one
+    int superClassIndex;
+    /// The class name
+    const char *className;
+    /// The signal definitions
+    SignalDefinitions signalDefinitions;
+    /// The slot definitions
+    SlotDefinitions slotDefinitions;
+    /// The property definitions
+    PropertyDefinitions propertyDefinitions;
+};
+
+#ifndef __cplusplus
+typedef struct DosQMetaObjectDescriptor DosQMetaObjectDescriptor;
+#endif
+
 /// Incapsulate all the QAbstractItemModel callbacks
 struct DosQAbstractItemModelCallbacks {
     RowCountCallback rowCount;
@@ -386,6 +552,77 @@ struct DosQAbstractItemModelCallbacks {
 typedef struct DosQAbstractItemModelCallbacks DosQAbstractItemModelCallbacks;
 #endif
 
+/// The value based variants of the DosQAbstractItemModelCallbacks
+/// \note Every callback is optional. When set it's used in place of the matching DosQAbstractItemModelCallbacks one
+/// \note The \p size must be set to sizeof(DosQAbstractItemModelValueCallbacks). Callbacks added by later versions
+/// are appended thus the ones missing from a smaller struct are considered not set
+struct DosQAbstractItemModelValueCallbacks {
+    int size;
+    RowCountValueCallback rowCount;
+    ColumnCountValueCallback columnCount;
+    DataValueCallback data;
+    SetDataValueCallback setData;
+    FlagsValueCallback flags;
+    IndexValueCallback index;
+    ParentValueCallback parent;
+    HasChildrenValueCallback hasChildren;
+    CanFetchMoreValueCallback canFetchMore;
+    FetchMoreValueCallback fetchMore;
+};
+
+#ifndef __cplusplus
+typedef struct DosQAbstractItemModelValueCallbacks DosQAbstractItemModelValueCallbacks;
+#endif
+
+/// The model data that can be declared static with dos_qabstractitemmodel_setStaticData()
+/// Static data is requested to the binding once and then served by the DOtherSide library
+enum DosQAbstractItemModelStaticData {
+    DosStaticRoleNames = 1, ///< roleNames() never changes
+    DosStaticFlags = 2, ///< flags() depends only on the column of the index
+    DosStaticHeaderData = 4 ///< headerData() changes only with an explicit invalidation
+};
+
+#ifndef __cplusplus
+typedef enum DosQAbstractItemModelStaticData DosQAbstractItemModelStaticData;
+#endif
+
+/// The type of a field of a DosQMappedFileModel record
+/// \note Numbers are stored in little endian byte order
+enum DosMappedFieldType {
+    DosMappedFieldInt8 = 0,
+    DosMappedFieldUInt8 = 1,
+    DosMappedFieldInt16 = 2,
+    DosMappedFieldUInt16 = 3,
+    DosMappedFieldInt32 = 4,
+    DosMappedFieldUInt32 = 5,
+    DosMappedFieldInt64 = 6,
+    DosMappedFieldUInt64 = 7,
+    DosMappedFieldFloat = 8,
+    DosMappedFieldDouble = 9,
+    DosMappedFieldUtf8 = 10 ///< UTF-8 text ending at the first NUL or at the end of the field
+};
+
+#ifndef __cplusplus
+typedef enum DosMappedFieldType DosMappedFieldType;
+#endif
+
+/// The definition of a field of a DosQMappedFileModel record, exposed as a role
+struct DosMappedFieldDefinition {
+    /// The role name
+    const char *name;
+    /// The DosMappedFieldType
+    int type;
+    /// The offset of the field from the beginning of the record
+    int offset;
+    /// The size of a DosMappedFieldUtf8 field. Zero or negative extends the field to the end of the record.
+    /// Ignored for numbers
+    int size;
+};
+
+#ifndef __cplusplus
+typedef struct DosMappedFieldDefinition DosMappedFieldDefinition;
+#endif
+
 enum DosQEventLoopProcessEventFlag {
     DosQEventLoopProcessEventFlagProcessAllEvents = 0x00,
     DosQEventLoopProcessEventFlagExcludeUserInputEvents = 0x01,
@@ -409,6 +646,43 @@ enum DosQtConnectionType {
 typedef enum DosQtConnectionType DosQtConnectionType;
 #endif
 
+enum DosQQmlComponentStatus {
+    DosQQmlComponentStatusNull = 0,
+    DosQQmlComponentStatusReady = 1,
+    DosQQmlComponentStatusLoading = 2,
+    DosQQmlComponentStatusError = 3
+};
+
+#ifndef __cplusplus
+typedef enum DosQQmlComponentStatus DosQQmlComponentStatus;
+#endif
+
+enum DosQQmlIncubatorStatus {
+    DosQQmlIncubatorStatusNull = 0,
+    DosQQmlIncubatorStatusReady = 1,
+    DosQQmlIncubatorStatusLoading = 2,
+    DosQQmlIncubatorStatusError = 3
+};
+
+#ifndef __cplusplus
+typedef enum DosQQmlIncubatorStatus DosQQmlIncubatorStatus;
+#endif
+
+/// When a singleton type is prepared and created
+enum DosQmlSingletonMode {
+    /// Prepared and created on the GUI thread when first used from QML
+    DosQmlSingletonModeLazy = 0,
+    /// Prepared and created on the GUI thread during the registration
+    DosQmlSingletonModeEager = 1,
+    /// Prepared on a worker thread right after the registration and created when first used
+    /// from QML, waiting for the preparation if it's still running
+    DosQmlSingletonModePreloaded = 2
+};
+
+#ifndef __cplusplus
+typedef enum DosQmlSingletonMode DosQmlSingletonMode;
+#endif
+
 #ifdef __cplusplus
 } // extern C
 #endif
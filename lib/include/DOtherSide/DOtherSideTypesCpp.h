@@ -32,6 +32,11 @@
 namespace DOS {
 
 struct ParameterDefinition {
+    ParameterDefinition(QString n, QMetaType::Type t)
+        : name(std::move(n))
+        , metaType(t)
+    {}
+
     ParameterDefinition(const ::ParameterDefinition &definition)
         : name(QString::fromUtf8(definition.name))
         , metaType(static_cast<QMetaType::Type>(definition.metaType))
@@ -19,7 +19,11 @@
 
 #pragma once
 
+// std
+#include <vector>
+
 // Qt
+#include <QtCore/QAbstractItemModel>
 #include <QtCore/QModelIndex>
 #include <QtCore/QVariant>
 #include <QtCore/QHash>
@@ -27,6 +31,7 @@
 #include <QtCore/QVector>
 
 // DOtherSide
+#include "DOtherSide/DOtherSideTypes.h"
 #include "DOtherSide/DosIQObjectImpl.h"
 
 namespace DOS {
@@ -61,6 +66,20 @@ public:
     /// @see QAbstractItemModel::endRemoveColumns
     virtual void publicEndRemoveColumns() = 0;
 
+    /// @see QAbstractItemModel::beginMoveRows
+    virtual bool publicBeginMoveRows(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                                     const QModelIndex &destinationParent, int destinationChild) = 0;
+
+    /// @see QAbstractItemModel::endMoveRows
+    virtual void publicEndMoveRows() = 0;
+
+    /// @see QAbstractItemModel::beginMoveColumns
+    virtual bool publicBeginMoveColumns(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                                        const QModelIndex &destinationParent, int destinationChild) = 0;
+
+    /// @see QAbstractItemModel::endMoveColumns
+    virtual void publicEndMoveColumns() = 0;
+
     /// @see QAbstractItemModel::beginResetModel
     virtual void publicBeginResetModel() = 0;
 
@@ -75,5 +94,89 @@ public:
 
     ///  @see QAbstractItemModel::hasIndex
     virtual bool hasIndex(int row, int column, const QModelIndex &parent = QModelIndex()) const = 0;
+
+    /// Queue a dataChanged for a cell of the root index. Queued cells are merged into
+    /// rectangular ranges and emitted on the next event loop iteration, on flush or
+    /// before any structural change
+    /// \note A null or empty roles array means all the roles
+    virtual void queueDataChanged(int row, int column, const int *roles, int rolesCount) = 0;
+
+    /// Emit the queued dataChanged signals
+    virtual void flushDataChanged() = 0;
+
+    /// Notify that an asynchronous fetch of rows for the given parent completed
+    /// \note This can be called from any thread. Rows are inserted in chunks on the model thread
+    virtual void fetchComplete(const QModelIndex &parent, int count) = 0;
+
+    /// Enable the caching of the data() results with the given memory budget in bytes.
+    /// A budget of 0 disables the cache
+    virtual void setDataCacheBudget(int bytes) = 0;
+
+    /// Prefetch the data() results in blocks of rows through the given callback. Null disables it
+    virtual void setFetchRangeCallback(FetchRangeCallback callback) = 0;
+
+    /// Implement moveRows() through the given callback. Null makes moveRows() fail
+    virtual void setMoveRowsCallback(MoveRowsCallback callback) = 0;
+
+    /// Use the given value based callbacks in place of the matching pointer based ones
+    virtual void setValueCallbacks(const DosQAbstractItemModelValueCallbacks &callbacks) = 0;
+
+    /// Make fetchMore() asynchronous and commit the fetched rows through the given callback. Null makes it synchronous
+    virtual void setCommitFetchedRowsCallback(CommitFetchedRowsCallback callback) = 0;
+
+    /// Return the QAbstractItemModel that implements the model logic
+    virtual QAbstractItemModel *itemModel() = 0;
+
+    /// Declare which model data is static as a combination of DosQAbstractItemModelStaticData
+    virtual void setStaticData(int staticData) = 0;
+
+    /// Drop the stored static role names
+    virtual void invalidateRoleNames() = 0;
+
+    /// Drop the stored static flags
+    virtual void invalidateFlags() = 0;
+
+    /// Drop the stored static header data of the given sections and emit headerDataChanged
+    virtual void invalidateHeaderData(Qt::Orientation orientation, int first, int last) = 0;
+
+    /// Update the rows of the root index to a new snapshot of unique row keys and
+    /// optional per-row content hashes by emitting the minimal set of change signals
+    virtual void applySnapshot(std::vector<quint64> keys, std::vector<quint64> hashes) = 0;
+
+    /// Serve index(), parent(), rowCount(), columnCount() and hasChildren() from a native
+    /// node tree with the given number of columns. The internal id of an index is the payload of its node
+    virtual void enableTree(int columnCount) = 0;
+
+    /// Insert nodes with the given unique payloads in the native tree
+    virtual bool treeInsert(const QModelIndex &parent, int row, const quintptr *payloads, int count) = 0;
+
+    /// Remove nodes and their descendants from the native tree
+    virtual bool treeRemove(const QModelIndex &parent, int row, int count) = 0;
+
+    /// Return the index of the native tree node with the given payload
+    virtual QModelIndex treeIndex(quintptr payload, int column) const = 0;
+
+    /// Remove all the nodes of the native tree
+    virtual void treeClear() = 0;
 };
 } // namespace dos
+
+Q_DECLARE_INTERFACE(DOS::DosIQAbstractItemModelImpl, "org.dotherside.DosIQAbstractItemModelImpl")
+
+namespace DOS {
+
+/// Return the DosIQAbstractItemModelImpl implemented by the given object or nullptr
+/// \note This is a single virtual call to QObject::qt_metacast, so it's cheaper than a dynamic_cast
+inline DosIQAbstractItemModelImpl *toModelImpl(QObject *object)
+{
+    return qobject_cast<DosIQAbstractItemModelImpl *>(object);
+}
+
+/// Return true if the given qt_metacast class name identifies DosIQAbstractItemModelImpl
+inline bool isModelImplInterface(const char *className)
+{
+    const char *interfaceId = qobject_interface_iid<DosIQAbstractItemModelImpl *>();
+    return className == interfaceId || (className && !qstrcmp(className, interfaceId));
+}
+
+} // namespace DOS
@@ -19,15 +19,23 @@
 
 #pragma once
 
+// std
+#include <memory>
+#include <vector>
+
 // Qt
 #include <QtCore/QAbstractItemModel>
 #include <QtCore/QAbstractListModel>
 #include <QtCore/QAbstractTableModel>
+#include <QtCore/QPersistentModelIndex>
 
 // DOtherSide
 #include "DOtherSide/DOtherSideTypes.h"
 #include "DOtherSide/DosQMetaObject.h"
 #include "DOtherSide/DosIQAbstractItemModelImpl.h"
+#include "DOtherSide/DosQModelDataCache.h"
+#include "DOtherSide/DosQDataChangedBuffer.h"
+#include "DOtherSide/DosQModelTree.h"
 
 namespace DOS {
 
@@ -41,6 +49,12 @@ public:
                              DObjectCallback dObjectCallback,
                              DosQAbstractItemModelCallbacks callbacks);
 
+    /// Constructor for models implemented natively
+    /// \note No binding callback is set thus the subclass must override the model methods
+    DosQAbstractGenericModel(void *modelObject,
+                             DosIQMetaObjectPtr metaObject,
+                             DObjectCallback dObjectCallback);
+
     /// @see IDynamicQObject::emitSignal
     bool emitSignal(QObject *emitter, const QString &name, const std::vector<QVariant> &argumentsValues) override;
 
@@ -50,6 +64,9 @@ public:
     /// @see QAbstractItemModel::qt_metacall
     int qt_metacall(QMetaObject::Call, int, void **) override;
 
+    /// @see QAbstractItemModel::qt_metacast
+    void *qt_metacast(const char *className) override;
+
     /// Return the model's row count
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
 
@@ -62,6 +79,10 @@ public:
     /// Sets the QVariant value at the given index and role
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
 
+    /// Move the rows to the given destination
+    bool moveRows(const QModelIndex &sourceParent, int sourceRow, int count,
+                  const QModelIndex &destinationParent, int destinationChild) override;
+
     /// Return the item flags for the given index
     Qt::ItemFlags flags(const QModelIndex &index) const override;
 
@@ -104,6 +125,20 @@ public:
     /// Expose endInsertColumns
     void publicEndRemoveColumns() override;
 
+    /// Expose beginMoveRows
+    bool publicBeginMoveRows(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                             const QModelIndex &destinationParent, int destinationChild) override;
+
+    /// Expose endMoveRows
+    void publicEndMoveRows() override;
+
+    /// Expose beginMoveColumns
+    bool publicBeginMoveColumns(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                                const QModelIndex &destinationParent, int destinationChild) override;
+
+    /// Expose endMoveColumns
+    void publicEndMoveColumns() override;
+
     /// Expose beginResetModel
     void publicBeginResetModel() override;
 
@@ -129,10 +164,163 @@ public:
 
     /// Expose the fetchMore
     void fetchMore(const QModelIndex &parent) override;
+
+    /// @see DosIQAbstractItemModelImpl::fetchComplete
+    void fetchComplete(const QModelIndex &parent, int count) override;
+
+    /// @see DosIQAbstractItemModelImpl::queueDataChanged
+    void queueDataChanged(int row, int column, const int *roles, int rolesCount) override;
+
+    /// @see DosIQAbstractItemModelImpl::flushDataChanged
+    void flushDataChanged() override;
+
+    /// @see DosIQAbstractItemModelImpl::setDataCacheBudget
+    void setDataCacheBudget(int bytes) override;
+
+    /// @see DosIQAbstractItemModelImpl::setFetchRangeCallback
+    void setFetchRangeCallback(FetchRangeCallback callback) override;
+
+    /// @see DosIQAbstractItemModelImpl::setMoveRowsCallback
+    void setMoveRowsCallback(MoveRowsCallback callback) override;
+
+    /// @see DosIQAbstractItemModelImpl::setValueCallbacks
+    void setValueCallbacks(const DosQAbstractItemModelValueCallbacks &callbacks) override;
+
+    /// @see DosIQAbstractItemModelImpl::setCommitFetchedRowsCallback
+    void setCommitFetchedRowsCallback(CommitFetchedRowsCallback callback) override;
+
+    /// @see DosIQAbstractItemModelImpl::itemModel
+    QAbstractItemModel *itemModel() override;
+
+    /// @see DosIQAbstractItemModelImpl::setStaticData
+    void setStaticData(int staticData) override;
+
+    /// @see DosIQAbstractItemModelImpl::invalidateRoleNames
+    void invalidateRoleNames() override;
+
+    /// @see DosIQAbstractItemModelImpl::invalidateFlags
+    void invalidateFlags() override;
+
+    /// @see DosIQAbstractItemModelImpl::invalidateHeaderData
+    void invalidateHeaderData(Qt::Orientation orientation, int first, int last) override;
+
+    /// @see DosIQAbstractItemModelImpl::applySnapshot
+    void applySnapshot(std::vector<quint64> keys, std::vector<quint64> hashes) override;
+
+    /// @see DosIQAbstractItemModelImpl::enableTree
+    void enableTree(int columnCount) override;
+
+    /// @see DosIQAbstractItemModelImpl::treeInsert
+    bool treeInsert(const QModelIndex &parent, int row, const quintptr *payloads, int count) override;
+
+    /// @see DosIQAbstractItemModelImpl::treeRemove
+    bool treeRemove(const QModelIndex &parent, int row, int count) override;
+
+    /// @see DosIQAbstractItemModelImpl::treeIndex
+    QModelIndex treeIndex(quintptr payload, int column) const override;
+
+    /// @see DosIQAbstractItemModelImpl::treeClear
+    void treeClear() override;
+
 private:
+    /// Return true if data() results should go through the cache
+    bool isDataCacheActive() const;
+
+    /// Suspend the data cache while rows or columns are inserted or removed
+    void suspendDataCache();
+
+    /// Resume the data cache after rows or columns have been inserted or removed
+    void resumeDataCache();
+
+    /// A fetch of rows started by fetchMore()
+    struct PendingFetch
+    {
+        /// The parent, kept up to date while the rows are loading
+        QPersistentModelIndex parent;
+        /// The parent as given to fetchMore(). Only used for matching the completion
+        QModelIndex requested;
+        bool root;
+        int remaining;
+        bool completed;
+
+        bool matches(const QModelIndex &index) const
+        {
+            return parent == index && (root || parent.isValid());
+        }
+    };
+
+    /// Return true if fetchMore() is asynchronous
+    bool isFetchAsync() const;
+
+    /// Return true if a fetch for the given parent is loading or being inserted
+    bool hasPendingFetch(const QModelIndex &parent) const;
+
+    /// Start the insertion of the rows of a completed fetch
+    void onFetchCompleted(const QModelIndex &parent, int count);
+
+    /// Insert a chunk of completed rows and schedule the next one
+    void insertFetchedRows();
+
+    /// Return the row count returned by the binding
+    int bindingRowCount(const QModelIndex &parent) const;
+
+    /// Return the column count returned by the binding
+    int bindingColumnCount(const QModelIndex &parent) const;
+
+    /// Return the data returned by the binding
+    QVariant bindingData(const QModelIndex &index, int role) const;
+
+    /// Return the flags returned by the binding
+    int bindingFlags(const QModelIndex &index) const;
+
+    /// Return the index created by the binding
+    QModelIndex bindingIndex(int row, int column, const QModelIndex &parent) const;
+
+    /// Return the parent returned by the binding
+    QModelIndex bindingParent(const QModelIndex &child) const;
+
+    /// Return the internal id used for caching the data of the given index
+    quintptr cacheId(const QModelIndex &index) const;
+
+    /// Return true if data() results can be prefetched in blocks of rows
+    /// \note Trees implemented by the binding aren't prefetched since creating the indexes of
+    /// a block would cost a call to the binding per row
+    bool canFetchRange() const;
+
+    /// Prefetch the block of rows containing the given index and store it in the cache
+    void fetchRange(const QModelIndex &index, int role) const;
+
+    /// Map a root row of the snapshot being replayed to the binding's new rows
+    QModelIndex snapshotIndex(const QModelIndex &index) const;
+
+    /// Return the native tree node of the given index or DosQModelTree::NoNode
+    int treeNode(const QModelIndex &index) const;
+
     std::unique_ptr<DosIQObjectImpl> m_impl;
     void *m_modelObject;
     DosQAbstractItemModelCallbacks m_callbacks;
+    CommitFetchedRowsCallback m_commitFetchedRows = nullptr;
+    DosQAbstractItemModelValueCallbacks m_valueCallbacks = {};
+    MoveRowsCallback m_moveRows = nullptr;
+    FetchRangeCallback m_fetchRange = nullptr;
+    mutable DosQModelDataCache m_dataCache;
+    bool m_dataCacheEnabled = false;
+    bool m_dataCacheSuspended = false;
+    DosQDataChangedBuffer m_pendingDataChanged;
+    std::vector<PendingFetch> m_pendingFetches;
+    bool m_fetchInsertionScheduled = false;
+    int m_staticData = 0;
+    mutable bool m_roleNamesStored = false;
+    mutable QHash<int, QByteArray> m_roleNames;
+    mutable QHash<int, Qt::ItemFlags> m_flags;
+    mutable QHash<QPair<int, int>, QVariant> m_headerData[2];
+    std::vector<quint64> m_snapshotKeys;
+    std::vector<quint64> m_snapshotHashes;
+    bool m_hasSnapshot = false;
+    std::vector<int> m_snapshotRows;
+    bool m_snapshotReplay = false;
+    std::unique_ptr<DosQModelTree> m_tree;
+    int m_treeColumnCount = 0;
 };
 
 using DosQAbstractItemModel = DosQAbstractGenericModel<QAbstractItemModel>;
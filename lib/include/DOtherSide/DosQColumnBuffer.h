@@ -0,0 +1,68 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <memory>
+
+// Qt
+#include <QtCore/QVariant>
+
+namespace DOS {
+
+/// Contiguous storage for the values of a single model role
+class DosQColumnBuffer
+{
+public:
+    /// Destructor
+    virtual ~DosQColumnBuffer() = default;
+
+    /// Return the metatype of the stored values
+    virtual int metaType() const = 0;
+
+    /// Return the number of stored values
+    virtual int size() const = 0;
+
+    /// Return the value at the given position
+    virtual QVariant value(int position) const = 0;
+
+    /// Insert \p count values before the given position
+    /// \note \p values is a C array of the type matching metaType(). A null pointer inserts default values
+    virtual void insert(int position, const void *values, int count) = 0;
+
+    /// Replace \p count values starting from the given position
+    /// \note \p values is a C array of the type matching metaType()
+    virtual void update(int position, const void *values, int count) = 0;
+
+    /// Remove \p count values starting from the given position
+    virtual void remove(int position, int count) = 0;
+
+    /// Replace \p count values starting from the given position with the values of another buffer
+    /// \note \p source must have the same metaType()
+    virtual void copy(int position, const DosQColumnBuffer &source, int sourcePosition, int count) = 0;
+
+    /// Create a buffer for the given metatype
+    /// \return The new buffer or nullptr if the metatype is not supported
+    /// \note Supported metatypes are Bool (bool), Int (int), LongLong (long long),
+    /// Float (float), Double (double) and QString (UTF-8 encoded const char *)
+    static std::unique_ptr<DosQColumnBuffer> create(int metaType);
+};
+
+} // namespace DOS
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <memory>
+#include <vector>
+
+// Qt
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+
+// DOtherSide
+#include "DOtherSide/DosQAbstractItemModel.h"
+#include "DOtherSide/DosQColumnBuffer.h"
+#include "DOtherSide/DosQModelJournal.h"
+
+namespace DOS {
+
+/// A list model whose data is stored in C++ typed column buffers, one for each role
+class DosQColumnarModel : public DosQAbstractListModel
+{
+public:
+    /// Constructor
+    /// \note The roles ids start from Qt::UserRole + 1
+    DosQColumnarModel(void *modelObject,
+                      DosIQMetaObjectPtr metaObject,
+                      DObjectCallback dObjectCallback,
+                      std::vector<std::unique_ptr<DosQColumnBuffer>> columns,
+                      const std::vector<QByteArray> &roleNames);
+
+    /// Return the number of roles
+    int roleCount() const;
+
+    /// Insert \p count rows before the given row
+    /// \note \p columns is an array of roleCount() C arrays. A null array inserts default values
+    bool insertRange(int row, int count, const void **columns);
+
+    /// Replace \p count rows starting from the given row
+    /// \note \p columns is an array of roleCount() C arrays. A null array leaves the role untouched
+    bool updateRange(int row, int count, const void **columns);
+
+    /// Remove \p count rows starting from the given row
+    bool removeRange(int row, int count);
+
+    /// Remove all the rows
+    void clear();
+
+    /// Record the insertion of \p count rows before the given row
+    /// \note This can be called from any thread. Recorded mutations are replayed on the next frame
+    void journalInsert(int row, int count, const void **columns);
+
+    /// Record the replacement of \p count rows starting from the given row
+    /// \note This can be called from any thread. Recorded mutations are replayed on the next frame
+    void journalUpdate(int row, int count, const void **columns);
+
+    /// Record the removal of \p count rows starting from the given row
+    /// \note This can be called from any thread. Recorded mutations are replayed on the next frame
+    void journalRemove(int row, int count);
+
+    /// Record the move of \p count rows starting from the given row before the destination row
+    /// \note This can be called from any thread. Recorded mutations are replayed on the next frame
+    void journalMove(int row, int count, int destination);
+
+    /// Apply the recorded mutations in recording order. Consecutive insertions and removals of
+    /// adjacent rows are signaled as one, as well as consecutive updates of overlapping rows
+    /// \note Mutations out of range are ignored
+    void replayJournal();
+
+    /// @see QAbstractItemModel::rowCount
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::columnCount
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::data
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /// @see QAbstractItemModel::setData
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+    /// @see QAbstractItemModel::flags
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    /// @see QAbstractItemModel::headerData
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /// @see QAbstractItemModel::index
+    QModelIndex index(int row, int column, const QModelIndex &parent) const override;
+
+    /// @see QAbstractItemModel::parent
+    QModelIndex parent(const QModelIndex &child) const override;
+
+    /// @see QAbstractItemModel::roleNames
+    QHash<int, QByteArray> roleNames() const override;
+
+    /// @see QAbstractItemModel::hasChildren
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::canFetchMore
+    bool canFetchMore(const QModelIndex &parent) const override;
+
+    /// @see QAbstractItemModel::fetchMore
+    void fetchMore(const QModelIndex &parent) override;
+
+private:
+    using Columns = std::vector<std::unique_ptr<DosQColumnBuffer>>;
+
+    /// Return the column buffer of the given role or nullptr
+    const DosQColumnBuffer *column(int role) const;
+
+    /// Copy the given C arrays in new buffers. Null arrays result in null buffers
+    Columns copyColumns(int count, const void **columns) const;
+
+    /// Record a journal entry and schedule a replay if the journal was empty
+    void record(DosQModelJournalEntry::Type type, int row, int count, int destination, Columns columns);
+
+    /// Apply a journal insertion
+    /// \return The number of consecutive entries merged in a single insertion
+    size_t replayInsert(const std::vector<std::unique_ptr<DosQModelJournalEntry>> &entries, size_t first);
+
+    /// Apply a journal removal
+    /// \return The number of consecutive entries merged in a single removal
+    size_t replayRemove(const std::vector<std::unique_ptr<DosQModelJournalEntry>> &entries, size_t first);
+
+    /// Apply a journal move
+    void replayMove(const DosQModelJournalEntry &entry);
+
+    std::vector<std::unique_ptr<DosQColumnBuffer>> m_columns;
+    std::vector<int> m_roleTypes;
+    DosQModelJournal m_journal;
+    QHash<int, QByteArray> m_roleNames;
+    int m_rowCount = 0;
+};
+
+} // namespace DOS
@@ -0,0 +1,79 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <vector>
+
+// Qt
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+namespace DOS {
+
+/// Collect changed cells and merge them into rectangular dataChanged ranges
+class DosQDataChangedBuffer
+{
+public:
+    /// A rectangle of changed cells
+    struct Range
+    {
+        int firstRow;
+        int lastRow;
+        int firstColumn;
+        int lastColumn;
+        /// The changed roles. An empty vector means all the roles
+        QVector<int> roles;
+    };
+
+    /// Add a changed cell
+    /// \note A null or empty roles array means all the roles
+    void add(int row, int column, const int *roles, int rolesCount);
+
+    /// Return true if no cell has been added since the last take()
+    bool isEmpty() const;
+
+    /// Return the merged ranges and empty the buffer
+    /// Consecutive rows of a column are merged first and the resulting runs are then
+    /// merged across adjacent columns with the same rows. The roles of merged cells are united
+    std::vector<Range> take();
+
+    /// Discard the added cells
+    void clear();
+
+private:
+    struct Cell
+    {
+        int column;
+        int row;
+        int roleSet;
+    };
+
+    int roleSetId(const int *roles, int rolesCount);
+    QVector<int> unite(std::vector<int> roleSets) const;
+
+    std::vector<Cell> m_cells;
+    std::vector<QVector<int>> m_roleSets;
+    QHash<QVector<int>, int> m_roleSetIds;
+    QVector<int> m_lastRoles;
+    int m_lastRoleSet = -1;
+};
+
+} // namespace DOS
@@ -19,9 +19,39 @@
 
 #pragma once
 
-#include "DOtherSide/DOtherSideTypes.h"
+// std
+#include <future>
+#include <memory>
+// Qt
+#include <QtCore/QObject>
+// DOtherSide
+#include "DOtherSide/DOtherSideTypesCpp.h"
 
 namespace DOS {
+
+struct DosQmlTypeRegistration;
+
+/// The creation state of a singleton type
+struct DosQmlSingletonState {
+    /// The preparation not yet started
+    PrepareDObject prepare = nullptr;
+    /// The preparation running on a worker thread
+    std::future<void> prepared;
+    /// The instance created ahead of its first use
+    QObject *instance = nullptr;
+    /// Create an instance of the wrapper class of the type
+    QObject *(*create)(const DosQmlTypeRegistration &) = nullptr;
+};
+
+/// A type registered in QML. Registrations live until the application exits
+struct DosQmlTypeRegistration {
+    QmlRegisterType data;
+    int id = -1;
+    std::unique_ptr<DosQmlSingletonState> singleton;
+};
+
 int dosQmlRegisterType(QmlRegisterType args);
-int dosQmlRegisterSingletonType(QmlRegisterType args);
+int dosQmlRegisterSingletonType(QmlRegisterType args,
+                                DosQmlSingletonMode mode = DosQmlSingletonModeLazy,
+                                PrepareDObject prepare = nullptr);
 }
@@ -0,0 +1,145 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <vector>
+
+// Qt
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+
+// DOtherSide
+#include "DOtherSide/DOtherSideTypes.h"
+#include "DOtherSide/DosQAbstractItemModel.h"
+
+namespace DOS {
+
+/// A read only list model whose rows are records of a memory mapped file.
+/// Records have a fixed size or are located by an index file of 64 bit little endian offsets
+class DosQMappedFileModel : public DosQAbstractListModel
+{
+public:
+    /// Constructor
+    /// \note The roles ids start from Qt::UserRole + 1
+    /// \note \p recordSize is ignored if \p indexPath is not empty
+    DosQMappedFileModel(void *modelObject,
+                        DosIQMetaObjectPtr metaObject,
+                        DObjectCallback dObjectCallback,
+                        const QString &dataPath,
+                        const QString &indexPath,
+                        int headerSize,
+                        int recordSize,
+                        const std::vector<DosMappedFieldDefinition> &fields);
+
+    /// Destructor
+    ~DosQMappedFileModel() override;
+
+    /// Return true if the files have been opened
+    bool isOpen() const;
+
+    /// Map the files again if they changed size and insert the new records
+    /// \note Truncated files reset the model. Files must only grow while mapped
+    bool refresh();
+
+    /// @see QAbstractItemModel::rowCount
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::columnCount
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::data
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /// @see QAbstractItemModel::setData
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+    /// @see QAbstractItemModel::flags
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    /// @see QAbstractItemModel::headerData
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /// @see QAbstractItemModel::index
+    QModelIndex index(int row, int column, const QModelIndex &parent) const override;
+
+    /// @see QAbstractItemModel::parent
+    QModelIndex parent(const QModelIndex &child) const override;
+
+    /// @see QAbstractItemModel::roleNames
+    QHash<int, QByteArray> roleNames() const override;
+
+    /// @see QAbstractItemModel::hasChildren
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::canFetchMore
+    bool canFetchMore(const QModelIndex &parent) const override;
+
+    /// @see QAbstractItemModel::fetchMore
+    void fetchMore(const QModelIndex &parent) override;
+
+private:
+    struct Field
+    {
+        int type;
+        int offset;
+        int size;
+    };
+
+    /// A mapped file
+    struct Mapping
+    {
+        QFile file;
+        uchar *data = nullptr;
+        qint64 size = 0;
+    };
+
+    /// Map the whole file again if its size changed
+    /// \return False if the file can't be mapped
+    static bool map(Mapping &mapping);
+
+    /// Unmap the file
+    static void unmap(Mapping &mapping);
+
+    /// Return the number of complete records in the mapped files
+    int recordCount() const;
+
+    /// Return the offset of the given record in the data file
+    qint64 recordOffset(int row) const;
+
+    /// Return true if the given record offset lies inside the mapped data
+    bool isValidOffset(qint64 offset) const;
+
+    /// Decode a field of the given record
+    QVariant decode(const Field &field, int row) const;
+
+    const int m_headerSize;
+    const int m_recordSize;
+    bool m_indexed;
+    bool m_open = false;
+    std::vector<Field> m_fields;
+    QHash<int, QByteArray> m_roleNames;
+    Mapping m_data;
+    Mapping m_index;
+    int m_rowCount = 0;
+};
+
+} // namespace DOS
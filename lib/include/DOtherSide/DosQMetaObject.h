@@ -23,7 +23,9 @@
 #include <memory>
 #include <unordered_map>
 #include <tuple>
+#include <vector>
 // Qt
+#include <QtCore/QDataStream>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QHash>
@@ -93,6 +95,13 @@ public:
                    const SlotDefinitions &slotDefinitions,
                    const PropertyDefinitions &propertyDefinitions);
 
+    /// Create a DosQMetaObject from the definitions written by serialize()
+    /// \note The stream status tells if the definitions were valid
+    DosQMetaObject(DosIQMetaObjectPtr superClassDosMetaObject, QDataStream &stream);
+
+    /// Write the class name and the definitions of this metaobject
+    void serialize(QDataStream &stream) const;
+
     QMetaMethod signal(const QString &signalName) const override;
     QMetaMethod readSlot(const char *propertyName) const override;
     QMetaMethod writeSlot(const char *propertyName) const override;
@@ -109,6 +118,26 @@ private:
     QHash<QString, QPair<int, int>> m_propertySlots;
 };
 
+/// The base classes of the dynamic metaobjects
+enum class DosQMetaObjectBase {
+    Object,
+    ItemModel,
+    ListModel,
+    TableModel
+};
+
+/// Return the shared metaobject of the given base class
+const DosIQMetaObjectPtr &baseMetaObject(DosQMetaObjectBase base);
+
+/// Write the given DosQMetaObjects in a binary table
+/// \return An empty array if a superclass is neither a base metaobject nor a metaobject preceding its subclass
+QByteArray serializeMetaObjects(const std::vector<DosIQMetaObjectPtr> &metaObjects);
+
+/// Create the DosQMetaObjects of a table written by serializeMetaObjects()
+/// \return An empty vector if the table is not valid or it doesn't contain \p count metaobjects
+/// \note The metaobjects are not shared with DosQMetaObjectCache
+std::vector<DosIQMetaObjectPtr> deserializeMetaObjects(const QByteArray &table, int count);
+
 /// This class simply holds a ptr to a IDosQMetaObject
 /// It's created and passed to the binded language
 class DosIQMetaObjectHolder
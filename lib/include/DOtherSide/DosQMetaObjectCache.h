@@ -0,0 +1,79 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <memory>
+#include <mutex>
+#include <vector>
+// Qt
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+// DOtherSide
+#include "DOtherSide/DOtherSideTypes.h"
+#include "DOtherSide/DOtherSideTypesCpp.h"
+
+namespace DOS {
+
+/// A cache of the DosQMetaObject created from their C definitions. Requests with the same
+/// superclass, class name and definitions share a DosQMetaObject as long as it's alive
+/// \note This class is thread safe
+class DosQMetaObjectCache
+{
+public:
+    /// Return the DosQMetaObject for the given definitions, creating it if it's not cached
+    DosIQMetaObjectPtr metaObject(const DosIQMetaObjectPtr &superClass,
+                                  const char *className,
+                                  const ::SignalDefinitions &signalDefinitions,
+                                  const ::SlotDefinitions &slotDefinitions,
+                                  const ::PropertyDefinitions &propertyDefinitions);
+
+    /// Return the DosQMetaObject for each descriptor, creating in a single pass the ones that aren't cached.
+    /// Return an empty vector if a descriptor has an invalid superclass
+    std::vector<DosIQMetaObjectPtr> metaObjects(const ::DosQMetaObjectDescriptor *descriptors, int count);
+
+    /// Return the number of requests served by a cached DosQMetaObject
+    int hits() const;
+
+    /// Return the number of requests that created a DosQMetaObject
+    int misses() const;
+
+    /// Return the cache used by dos_qmetaobject_create()
+    static DosQMetaObjectCache &instance();
+
+private:
+    /// Return the key identifying the given definitions
+    static QByteArray key(const DosIQMetaObjectPtr &superClass,
+                          const char *className,
+                          const ::SignalDefinitions &signalDefinitions,
+                          const ::SlotDefinitions &slotDefinitions,
+                          const ::PropertyDefinitions &propertyDefinitions);
+
+    /// Remove the entries whose DosQMetaObject has been destroyed
+    void removeExpired();
+
+    mutable std::mutex m_mutex;
+    QHash<QByteArray, std::weak_ptr<const DosIQMetaObject>> m_entries;
+    int m_hits = 0;
+    int m_misses = 0;
+    int m_removeExpiredThreshold = 64;
+};
+
+} // namespace DOS
@@ -0,0 +1,125 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <vector>
+
+// Qt
+#include <QtCore/QCache>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+// DOtherSide
+#include "DOtherSide/DosQtCompatUtils.h"
+
+namespace DOS {
+
+/// Identify a single data() result of a model
+struct DosQModelDataCacheKey
+{
+    int row;
+    int column;
+    quintptr internalId;
+    int role;
+};
+
+bool operator==(const DosQModelDataCacheKey &lhs, const DosQModelDataCacheKey &rhs);
+
+HashValue qHash(const DosQModelDataCacheKey &key, HashValue seed = 0);
+
+/// Least recently used cache of the data() results of a model
+/// \note Values are stored against stable ids of their row and column thus structural changes
+/// only update the ids of the positions. Values of removed or invalidated positions can't be
+/// reached anymore and are the first ones to be evicted
+class DosQModelDataCache
+{
+public:
+    /// The default memory budget in bytes
+    static const int DefaultBudget = 4 * 1024 * 1024;
+
+    /// Constructor
+    explicit DosQModelDataCache(int budget = DefaultBudget);
+
+    /// Return the memory budget in bytes
+    int budget() const;
+
+    /// Set the memory budget in bytes
+    void setBudget(int budget);
+
+    /// Return true and fill the result if the given key is stored
+    bool lookup(const DosQModelDataCacheKey &key, QVariant *result) const;
+
+    /// Store the value for the given key
+    void insert(const DosQModelDataCacheKey &key, const QVariant &value);
+
+    /// Remove the values of the rows [first, last] for every column and role
+    void invalidateRows(int first, int last);
+
+    /// Shift the values for rows inserted before \p first
+    void insertRows(int first, int count);
+
+    /// Remove the values of the removed rows and shift the following ones
+    void removeRows(int first, int count);
+
+    /// Move the values of the rows [first, last] before the row \p destination
+    void moveRows(int first, int last, int destination);
+
+    /// Shift the values for columns inserted before \p first
+    void insertColumns(int first, int count);
+
+    /// Remove the values of the removed columns and shift the following ones
+    void removeColumns(int first, int count);
+
+    /// Move the values of the columns [first, last] before the column \p destination
+    void moveColumns(int first, int last, int destination);
+
+    /// Remove all the stored values
+    void clear();
+
+private:
+    /// Return the key of the values stored for the given key or false if none can be
+    bool storedKey(const DosQModelDataCacheKey &key, DosQModelDataCacheKey *result) const;
+
+    /// Make sure the ids of the positions before \p size exist
+    void reserveIds(std::vector<quint32> &ids, int size);
+
+    /// Give new ids to the positions [first, last]
+    void renewIds(std::vector<quint32> &ids, int first, int last);
+
+    /// Insert new ids for the positions inserted before \p first
+    void insertIds(std::vector<quint32> &ids, int first, int count);
+
+    /// Remove the ids of the removed positions
+    void removeIds(std::vector<quint32> &ids, int first, int count);
+
+    /// Move the ids of the positions [first, last] before the position \p destination
+    void moveIds(std::vector<quint32> &ids, int first, int last, int destination);
+
+    /// Return an id never used before
+    quint32 nextId();
+
+    QCache<DosQModelDataCacheKey, QVariant> m_values;
+    std::vector<quint32> m_rowIds;
+    std::vector<quint32> m_columnIds;
+    quint32 m_nextId = 0;
+};
+
+} // namespace DOS
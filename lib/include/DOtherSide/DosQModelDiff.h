@@ -0,0 +1,87 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <vector>
+
+// Qt
+#include <QtCore/QtGlobal>
+
+namespace DOS {
+
+/// A single step of the edit script that turns a model snapshot into another
+struct DosQModelDiffOperation
+{
+    enum Type {
+        Remove, ///< Remove the rows [first, last]
+        Move, ///< Move the rows [first, last] before the row destination
+        Layout, ///< Sort the rows in their final order with a layout change
+        Insert, ///< Insert the rows [first, last]
+        Change ///< The content of the rows [first, last] changed
+    };
+
+    Type type;
+    int first;
+    int last;
+    int destination;
+};
+
+/// Compute the edit script between two snapshots of a flat model
+/// Each snapshot is a sequence of unique row keys with optional per-row content hashes.
+/// Operations are ordered as Qt expects them to be replayed: removals from the bottom,
+/// moves, insertions from the top and finally content changes. Rows are numbered
+/// against the model state left by the previous operations.
+class DosQModelDiff
+{
+public:
+    /// Above this number of moved rows a single layout change is emitted instead
+    static const int MaxMoves = 128;
+
+    /// Constructor
+    DosQModelDiff(const std::vector<quint64> &oldKeys,
+                  const std::vector<quint64> &oldHashes,
+                  const std::vector<quint64> &newKeys,
+                  const std::vector<quint64> &newHashes);
+
+    /// Return true if the snapshots contain duplicated keys and can't be diffed
+    bool requiresReset() const;
+
+    /// Return the new row of every old row or -1 for removed rows
+    const std::vector<int> &rowMap() const;
+
+    /// Return the edit script
+    const std::vector<DosQModelDiffOperation> &operations() const;
+
+private:
+    void computeRemovals();
+    void computeMoves(std::vector<int> rows, int newCount);
+    void computeInsertions(const std::vector<int> &newToOld);
+    void computeChanges(const std::vector<int> &newToOld,
+                        const std::vector<quint64> &oldHashes,
+                        const std::vector<quint64> &newHashes);
+    void append(DosQModelDiffOperation::Type type, int first, int last, int destination = -1);
+
+    bool m_requiresReset = false;
+    std::vector<int> m_rowMap;
+    std::vector<DosQModelDiffOperation> m_operations;
+};
+
+} // namespace DOS
@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// DOtherSide
+#include "DOtherSide/DosQColumnBuffer.h"
+
+namespace DOS {
+
+/// A model mutation recorded in a DosQModelJournal
+struct DosQModelJournalEntry
+{
+    enum class Type {
+        Insert,
+        Remove,
+        Move,
+        Update
+    };
+
+    Type type;
+    int row;
+    int count;
+    int destination;
+    /// The values of the inserted or updated rows, one buffer for each role.
+    /// Null buffers are default values for insertions and untouched roles for updates
+    std::vector<std::unique_ptr<DosQColumnBuffer>> columns;
+    DosQModelJournalEntry *next = nullptr;
+};
+
+/// A lock free multiple producers single consumer queue of model mutations
+class DosQModelJournal
+{
+public:
+    /// Constructor
+    DosQModelJournal() = default;
+
+    /// Destructor
+    ~DosQModelJournal();
+
+    DosQModelJournal(const DosQModelJournal &) = delete;
+    DosQModelJournal &operator=(const DosQModelJournal &) = delete;
+
+    /// Record an entry
+    /// \return True if the journal was empty
+    /// \note This can be called from any thread
+    bool push(std::unique_ptr<DosQModelJournalEntry> entry);
+
+    /// Take all the recorded entries in recording order
+    std::vector<std::unique_ptr<DosQModelJournalEntry>> take();
+
+private:
+    std::atomic<DosQModelJournalEntry *> m_head {nullptr};
+};
+
+} // namespace DOS
@@ -0,0 +1,108 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <vector>
+
+// Qt
+#include <QtCore/QHash>
+#include <QtCore/QtGlobal>
+
+namespace DOS {
+
+/// Arena backed storage for the structure of a tree model.
+/// Nodes are identified by their position in the arena and carry a binding payload
+/// that is unique in the tree and used as QModelIndex internal id
+class DosQModelTree
+{
+public:
+    enum : int {
+        RootNode = 0, ///< The invisible root node
+        NoNode = -1 ///< A missing node
+    };
+
+    /// Constructor
+    DosQModelTree();
+
+    /// Return the node with the given payload or NoNode
+    int node(quintptr payload) const;
+
+    /// Return the payload of the given node
+    quintptr payload(int node) const;
+
+    /// Return the parent of the given node or NoNode for the root node
+    int parent(int node) const;
+
+    /// Return the number of children of the given node
+    int childCount(int node) const;
+
+    /// Return the child of the given node at the given row or NoNode
+    /// \note Lookups near the previous lookup of the same parent are constant time
+    int child(int node, int row) const;
+
+    /// Return the row of the given node in its parent
+    int row(int node) const;
+
+    /// Return true if insert() would succeed with the same arguments
+    bool canInsert(int parent, int row, const quintptr *payloads, int count) const;
+
+    /// Insert \p count nodes with the given payloads before the given row of the parent node
+    /// \return False if the row is out of range or a payload is already in the tree
+    bool insert(int parent, int row, const quintptr *payloads, int count);
+
+    /// Remove \p count nodes and their descendants starting from the given row of the parent node
+    /// \return False if the rows are out of range
+    bool remove(int parent, int row, int count);
+
+    /// Remove all the nodes
+    void clear();
+
+private:
+    struct Node
+    {
+        quintptr payload = 0;
+        int parent = NoNode;
+        int firstChild = NoNode;
+        int lastChild = NoNode;
+        int previousSibling = NoNode;
+        int nextSibling = NoNode;
+        int childCount = 0;
+        mutable int row = 0;
+        mutable int cursorNode = NoNode;
+        mutable int cursorRow = 0;
+        mutable bool rowsDirty = false;
+    };
+
+    /// Return a node from the free list or a new one
+    int allocate();
+
+    /// Return the given node and its descendants to the free list
+    void release(int node);
+
+    /// Update the rows of the children of the given node
+    void renumber(const Node &node) const;
+
+    std::vector<Node> m_nodes;
+    QHash<quintptr, int> m_nodeByPayload;
+    int m_freeNode = NoNode;
+};
+
+} // namespace DOS
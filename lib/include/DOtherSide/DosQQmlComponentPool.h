@@ -0,0 +1,81 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <memory>
+#include <vector>
+// Qt
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlContext>
+// DOtherSide
+#include "DOtherSide/DOtherSideTypes.h"
+#include "DOtherSide/DosQQmlIncubator.h"
+
+namespace DOS {
+
+/// Keeps up to a given number of objects of a QQmlComponent ready to be handed out.
+/// Released objects are reset by the binding through the recycle callback and reused
+/// instead of being destroyed, so their binded objects are reused as well
+class DosQQmlComponentPool : public QObject
+{
+public:
+    /// Constructor
+    DosQQmlComponentPool(QQmlComponent *component, QQmlContext *context, int capacity,
+                         DosQQmlComponentPoolRecycleCallback callback, void *callbackData);
+
+    /// Incubate objects until the pool is full
+    void fill();
+
+    /// Return a pooled object or create a new one if the pool is empty
+    QObject *acquire();
+
+    /// Give back an object to the pool or delete it if the pool is full
+    void release(QObject *object);
+
+    /// Return the number of objects ready in the pool
+    int available() const;
+
+private:
+    /// Called by the incubators started by fill()
+    static void DOS_CALL onIncubated(void *self, DosQObject *object);
+
+    /// Return true if the pool holds as many objects as its capacity
+    bool isFull() const;
+
+    /// Park an object in the pool
+    /// \note The object is deleted if the pool is full
+    void store(QObject *object);
+
+    /// Delete the incubators that completed
+    void removeCompletedIncubators();
+
+    QPointer<QQmlComponent> m_component;
+    QPointer<QQmlContext> m_context;
+    int m_capacity;
+    DosQQmlComponentPoolRecycleCallback m_callback;
+    void *m_callbackData;
+    std::vector<QObject *> m_objects;
+    std::vector<std::unique_ptr<DosQQmlIncubator>> m_incubators;
+};
+
+} // namespace DOS
@@ -0,0 +1,67 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Qt
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtQml/QQmlIncubator>
+// DOtherSide
+#include "DOtherSide/DOtherSideTypes.h"
+
+namespace DOS {
+
+/// A QQmlIncubator that notifies its completion through a callback
+class DosQQmlIncubator : public QQmlIncubator
+{
+public:
+    /// Constructor
+    DosQQmlIncubator(DosQQmlIncubatorCallback callback, void *callbackData);
+
+protected:
+    /// @see QQmlIncubator::statusChanged
+    void statusChanged(Status status) override;
+
+private:
+    DosQQmlIncubatorCallback m_callback;
+    void *m_callbackData;
+};
+
+/// A QQmlIncubationController that incubates for a given time every frame
+/// The timer runs only while there are objects to incubate
+class DosQQmlIncubationController : public QObject, public QQmlIncubationController
+{
+public:
+    /// Constructor
+    DosQQmlIncubationController(int budget, QObject *parent = nullptr);
+
+    /// Set the milliseconds spent incubating in each frame
+    void setBudget(int budget);
+
+protected:
+    /// @see QQmlIncubationController::incubatingObjectCountChanged
+    void incubatingObjectCountChanged(int count) override;
+
+private:
+    QTimer m_timer;
+    int m_budget;
+};
+
+} // namespace DOS
@@ -0,0 +1,62 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <vector>
+// Qt
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+#include <QtQml/QQmlComponent>
+// DOtherSide
+#include "DOtherSide/DOtherSideTypes.h"
+
+namespace DOS {
+
+/// Compiles QML files one after another on the QML type loader thread so that
+/// later loads of the same files are served by the engine type cache.
+/// The compiled components are kept until the preloader, a child of the engine, is destroyed
+class DosQQmlPreloader : public QObject
+{
+public:
+    /// Constructor
+    DosQQmlPreloader(QQmlEngine *engine, std::vector<QUrl> urls,
+                     DosQQmlPreloadCallback callback, void *callbackData);
+
+    /// Start compiling the files
+    void start();
+
+private:
+    /// Load the next file or do nothing if all have been loaded
+    void loadNext();
+
+    /// Report the compilation of the current file and continue with the next one
+    void onStatusChanged(QQmlComponent *component, QQmlComponent::Status status);
+
+    QQmlEngine *m_engine;
+    std::vector<QUrl> m_urls;
+    DosQQmlPreloadCallback m_callback;
+    void *m_callbackData;
+    size_t m_current = 0;
+    QElapsedTimer m_timer;
+};
+
+} // namespace DOS
@@ -0,0 +1,126 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Qt
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+
+// DOtherSide
+#include "DOtherSide/DosQAbstractItemModel.h"
+#include "DOtherSide/DosQColumnBuffer.h"
+
+namespace DOS {
+
+/// An append only list model that keeps the last rows up to a fixed capacity.
+/// Rows are appended from any thread and published once per frame
+class DosQRingBufferModel : public DosQAbstractListModel
+{
+public:
+    /// Constructor
+    /// \note The roles ids start from Qt::UserRole + 1
+    DosQRingBufferModel(void *modelObject,
+                        DosIQMetaObjectPtr metaObject,
+                        DObjectCallback dObjectCallback,
+                        int capacity,
+                        const std::vector<int> &roleTypes,
+                        const std::vector<QByteArray> &roleNames);
+
+    /// Return the maximum number of rows
+    int capacity() const;
+
+    /// Stage \p count rows for publishing on the next frame
+    /// \note \p columns is an array of one C array for each role. A null array appends default values.
+    /// This can be called from any thread
+    void append(int count, const void **columns);
+
+    /// Publish the staged rows, evicting the oldest rows beyond the capacity
+    void publish();
+
+    /// Remove all the rows, including the staged ones
+    void clear();
+
+    /// @see QAbstractItemModel::rowCount
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::columnCount
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::data
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /// @see QAbstractItemModel::setData
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+    /// @see QAbstractItemModel::flags
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    /// @see QAbstractItemModel::headerData
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /// @see QAbstractItemModel::index
+    QModelIndex index(int row, int column, const QModelIndex &parent) const override;
+
+    /// @see QAbstractItemModel::parent
+    QModelIndex parent(const QModelIndex &child) const override;
+
+    /// @see QAbstractItemModel::roleNames
+    QHash<int, QByteArray> roleNames() const override;
+
+    /// @see QAbstractItemModel::hasChildren
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @see QAbstractItemModel::canFetchMore
+    bool canFetchMore(const QModelIndex &parent) const override;
+
+    /// @see QAbstractItemModel::fetchMore
+    void fetchMore(const QModelIndex &parent) override;
+
+private:
+    using Columns = std::vector<std::unique_ptr<DosQColumnBuffer>>;
+
+    /// Create one empty buffer for each role
+    static Columns createColumns(const std::vector<int> &roleTypes);
+
+    /// Copy \p count staged rows into the ring starting from the given row
+    void writeRows(int row, int sourceRow, int count);
+
+    /// Return the position in the ring of the given row
+    int position(int row) const;
+
+    const int m_capacity;
+    Columns m_rows;
+    QHash<int, QByteArray> m_roleNames;
+    int m_head = 0;
+    int m_rowCount = 0;
+
+    std::mutex m_stagingMutex;
+    Columns m_staging;
+    int m_stagedCount = 0;
+    bool m_publishScheduled = false;
+    Columns m_publishing;
+};
+
+} // namespace DOS
@@ -0,0 +1,151 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// std
+#include <vector>
+
+// Qt
+#include <QtCore/QMetaObject>
+#include <QtCore/QSortFilterProxyModel>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+namespace DOS {
+
+/// A QSortFilterProxyModel that sorts and filters on snapshots of the source role values
+/// \note Only the top level rows are snapshotted. Child rows are compared and filtered
+/// through the source model like in QSortFilterProxyModel
+/// \note Snapshots not matching the current roles or filter column are refreshed on the next
+/// event loop iteration, meanwhile the source model is read directly
+class DosQSortFilterProxyModel : public QSortFilterProxyModel
+{
+public:
+    /// Constructor
+    explicit DosQSortFilterProxyModel(QObject *parent = nullptr);
+
+    /// @see QSortFilterProxyModel::setSourceModel
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    /// @see QSortFilterProxyModel::sort
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    /// Accept only the rows whose filter role value contains the given string
+    /// \note A null string restores the QSortFilterProxyModel filtering
+    void setFilterString(const QString &filter);
+
+protected:
+    /// @see QSortFilterProxyModel::lessThan
+    bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const override;
+
+    /// @see QSortFilterProxyModel::filterAcceptsRow
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    /// The snapshot of the values of a role in a source column
+    struct Keys {
+        int role = -1;
+        int column = -1;
+        bool valid = false;
+        bool numeric = true;
+        std::vector<double> numbers;
+        std::vector<QString> strings;
+
+        int size() const
+        {
+            return static_cast<int>(numeric ? numbers.size() : strings.size());
+        }
+    };
+
+    /// Store the value of the given row in the keys
+    /// \return False if the value doesn't match the keys type
+    static bool storeKey(Keys &keys, int row, const QVariant &value);
+
+    /// Read all the values of the given role and column
+    /// \note If \p allowNumbers is false the values are always stored as strings
+    Keys createKeys(int role, int column, bool allowNumbers) const;
+
+    /// Compare the sort keys of two source rows
+    int compareSortKeys(int left, int right, Qt::CaseSensitivity caseSensitivity, bool localeAware) const;
+
+    /// Return true if the ranks match the current sort keys and settings
+    bool hasValidRanks() const;
+
+    /// Return true if the given source row passes the filter string
+    bool matchesFilterString(int row, Qt::CaseSensitivity caseSensitivity) const;
+
+    /// Return true if the given source row passes the filter string reading the source model
+    bool sourceMatchesFilterString(int sourceRow, const QModelIndex &sourceParent) const;
+
+    /// Return true if the sort keys don't match the sort role and column
+    bool isSortKeysOutdated() const;
+
+    /// Return true if the filter keys don't match the filter role and column
+    bool isFilterKeysOutdated() const;
+
+    /// Refresh the outdated snapshots on the next event loop iteration
+    void scheduleRefresh() const;
+
+    /// Refresh the outdated snapshots
+    void refreshOutdatedKeys();
+
+    /// Snapshot the sort role values of the given column and rank them
+    void refreshSortKeys(int role, int column);
+
+    /// Rank the sort keys
+    void rankSortKeys();
+
+    /// Snapshot the filter role values of the given column and filter them
+    void refreshFilterKeys(int role, int column);
+
+    /// Match the filter string against the filter keys
+    /// \note If \p incremental is true only the rows accepted by the previous filter are tested
+    void refilter(bool incremental);
+
+    /// Called when the source model inserts rows
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+
+    /// Called when the source model removes rows
+    void onSourceRowsRemoved(const QModelIndex &parent, int first, int last);
+
+    /// Called when the source model changes data
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+
+    /// Called when the source model changes its layout or is reset
+    void onSourceLayoutChanged();
+
+    /// Return true if the source model has no child rows
+    bool isSourceFlat() const;
+
+    QVector<QMetaObject::Connection> m_sourceConnections;
+    bool m_flatSource = false;
+    Keys m_sortKeys;
+    std::vector<int> m_ranks;
+    bool m_ranksValid = false;
+    Qt::CaseSensitivity m_ranksCaseSensitivity = Qt::CaseSensitive;
+    bool m_ranksLocaleAware = false;
+    Keys m_filterKeys;
+    QString m_filterString;
+    Qt::CaseSensitivity m_filterCaseSensitivity = Qt::CaseSensitive;
+    std::vector<char> m_accepted;
+    mutable bool m_refreshScheduled = false;
+};
+
+} // namespace DOS
@@ -55,6 +55,8 @@ inline const char* metaTypeName(QMetaType::Type type)
     return QMetaType(type).name();
 }
 
+using HashValue = size_t;
+
 #else
 
 inline int parameterMetaType(const QMetaMethod& method, int index)
@@ -87,6 +89,8 @@ inline const char* metaTypeName(QMetaType::Type type)
     return QMetaType::typeName(type);
 }
 
+using HashValue = uint;
+
 #endif
 
 }
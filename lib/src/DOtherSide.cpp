@@ -19,6 +19,9 @@
 
 #include "DOtherSide/DOtherSide.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
 #include <QtCore/QModelIndex>
@@ -26,6 +29,7 @@
 #include <QtCore/QPointer>
 #include <QtCore/QResource>
 #include <QtGui/QGuiApplication>
+#include <QtQml/QQmlComponent>
 #include <QtQml/QQmlContext>
 #include <QtQml/QQmlApplicationEngine>
 #include <QtQuick/QQuickView>
@@ -37,10 +41,19 @@
 
 #include "DOtherSide/DOtherSideTypesCpp.h"
 #include "DOtherSide/DosQMetaObject.h"
+#include "DOtherSide/DosQMetaObjectCache.h"
 #include "DOtherSide/DosQObject.h"
 #include "DOtherSide/DosQAbstractItemModel.h"
+#include "DOtherSide/DosQColumnarModel.h"
+#include "DOtherSide/DosQRingBufferModel.h"
+#include "DOtherSide/DosQMappedFileModel.h"
+#include "DOtherSide/DosQSortFilterProxyModel.h"
+#include "DOtherSide/DosQModelIndexValue.h"
 #include "DOtherSide/DosQDeclarative.h"
 #include "DOtherSide/DosQQuickImageProvider.h"
+#include "DOtherSide/DosQQmlComponentPool.h"
+#include "DOtherSide/DosQQmlIncubator.h"
+#include "DOtherSide/DosQQmlPreloader.h"
 #include "DOtherSide/DosLambdaInvoker.h"
 
 namespace {
@@ -50,6 +63,29 @@ void register_meta_types()
     qRegisterMetaType<QVector<int>>();
 }
 
+/// Return the native model of a handle returned by its create function
+/// \note The handles of native models are typed thus no runtime type check is needed
+template<class Model>
+Model *toItemModel(void *vptr)
+{
+    return static_cast<Model *>(static_cast<QObject *>(vptr));
+}
+
+DOS::QmlRegisterType toQmlRegisterType(const ::QmlRegisterType *cArgs)
+{
+    auto holder = static_cast<DOS::DosIQMetaObjectHolder *>(cArgs->staticMetaObject);
+
+    DOS::QmlRegisterType args;
+    args.major = cArgs->major;
+    args.minor = cArgs->minor;
+    args.uri = cArgs->uri;
+    args.qml = cArgs->qml;
+    args.staticMetaObject = holder->data();
+    args.createDObject = cArgs->createDObject;
+    args.deleteDObject = cArgs->deleteDObject;
+    return args;
+}
+
 }
 
 char *convert_to_cstring(const QByteArray &array)
@@ -163,12 +199,159 @@ void dos_qqmlapplicationengine_addImageProvider(DosQQmlApplicationEngine *vptr,
     engine->addImageProvider(QString(name), provider);
 }
 
+void dos_qqmlapplicationengine_set_incubation_budget(::DosQQmlApplicationEngine *vptr, int msecs)
+{
+    auto engine = static_cast<QQmlApplicationEngine *>(vptr);
+    auto controller = dynamic_cast<DOS::DosQQmlIncubationController *>(engine->incubationController());
+    if (msecs <= 0) {
+        delete controller;
+    } else if (controller) {
+        controller->setBudget(msecs);
+    } else {
+        // The controller unregisters itself when deleted along with the engine
+        engine->setIncubationController(new DOS::DosQQmlIncubationController(msecs, engine));
+    }
+}
+
+void dos_qqmlapplicationengine_preload(::DosQQmlApplicationEngine *vptr, ::DosQUrl **urls, int count,
+                                       ::DosQQmlPreloadCallback callback, void *callbackData)
+{
+    auto engine = static_cast<QQmlApplicationEngine *>(vptr);
+    std::vector<QUrl> files;
+    files.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+        files.push_back(*static_cast<QUrl *>(urls[i]));
+    auto preloader = new DOS::DosQQmlPreloader(engine, std::move(files), callback, callbackData);
+    preloader->start();
+}
+
 void dos_qqmlapplicationengine_delete(::DosQQmlApplicationEngine *vptr)
 {
     auto engine = static_cast<QQmlApplicationEngine *>(vptr);
     delete engine;
 }
 
+::DosQQmlComponent *dos_qqmlcomponent_create(::DosQQmlApplicationEngine *engine,
+                                             ::DosQQmlComponentStatusCallback callback,
+                                             void *callbackData)
+{
+    auto component = new QQmlComponent(static_cast<QQmlApplicationEngine *>(engine));
+    if (callback) {
+        QObject::connect(component, &QQmlComponent::statusChanged, [callback, callbackData](QQmlComponent::Status status) {
+            callback(callbackData, status);
+        });
+    }
+    return component;
+}
+
+void dos_qqmlcomponent_load_url(::DosQQmlComponent *vptr, ::DosQUrl *url, bool asynchronous)
+{
+    auto component = static_cast<QQmlComponent *>(vptr);
+    auto qurl = static_cast<QUrl *>(url);
+    component->loadUrl(*qurl, asynchronous ? QQmlComponent::Asynchronous : QQmlComponent::PreferSynchronous);
+}
+
+void dos_qqmlcomponent_set_data(::DosQQmlComponent *vptr, const char *data, ::DosQUrl *url)
+{
+    auto component = static_cast<QQmlComponent *>(vptr);
+    auto qurl = static_cast<QUrl *>(url);
+    component->setData(QByteArray(data), *qurl);
+}
+
+int dos_qqmlcomponent_status(const ::DosQQmlComponent *vptr)
+{
+    auto component = static_cast<const QQmlComponent *>(vptr);
+    return component->status();
+}
+
+char *dos_qqmlcomponent_error_string(const ::DosQQmlComponent *vptr)
+{
+    auto component = static_cast<const QQmlComponent *>(vptr);
+    return convert_to_cstring(component->errorString());
+}
+
+::DosQObject *dos_qqmlcomponent_create_object(::DosQQmlComponent *vptr, ::DosQQmlContext *context)
+{
+    auto component = static_cast<QQmlComponent *>(vptr);
+    QObject *result = component->create(static_cast<QQmlContext *>(context));
+    if (result)
+        QQmlEngine::setObjectOwnership(result, QQmlEngine::CppOwnership);
+    return result;
+}
+
+::DosQQmlIncubator *dos_qqmlcomponent_incubate(::DosQQmlComponent *vptr, ::DosQQmlContext *context,
+                                               ::DosQQmlIncubatorCallback callback, void *callbackData)
+{
+    auto component = static_cast<QQmlComponent *>(vptr);
+    auto incubator = new DOS::DosQQmlIncubator(callback, callbackData);
+    component->create(*incubator, static_cast<QQmlContext *>(context));
+    return incubator;
+}
+
+void dos_qqmlcomponent_delete(::DosQQmlComponent *vptr)
+{
+    auto component = static_cast<QQmlComponent *>(vptr);
+    delete component;
+}
+
+int dos_qqmlincubator_status(const ::DosQQmlIncubator *vptr)
+{
+    auto incubator = static_cast<const DOS::DosQQmlIncubator *>(vptr);
+    return incubator->status();
+}
+
+void dos_qqmlincubator_force_completion(::DosQQmlIncubator *vptr)
+{
+    auto incubator = static_cast<DOS::DosQQmlIncubator *>(vptr);
+    incubator->forceCompletion();
+}
+
+void dos_qqmlincubator_delete(::DosQQmlIncubator *vptr)
+{
+    auto incubator = static_cast<DOS::DosQQmlIncubator *>(vptr);
+    delete incubator;
+}
+
+::DosQQmlComponentPool *dos_qqmlcomponentpool_create(::DosQQmlComponent *component, ::DosQQmlContext *context,
+                                                     int capacity,
+                                                     ::DosQQmlComponentPoolRecycleCallback callback,
+                                                     void *callbackData)
+{
+    return new DOS::DosQQmlComponentPool(static_cast<QQmlComponent *>(component),
+                                         static_cast<QQmlContext *>(context),
+                                         capacity, callback, callbackData);
+}
+
+void dos_qqmlcomponentpool_fill(::DosQQmlComponentPool *vptr)
+{
+    auto pool = static_cast<DOS::DosQQmlComponentPool *>(vptr);
+    pool->fill();
+}
+
+::DosQObject *dos_qqmlcomponentpool_acquire(::DosQQmlComponentPool *vptr)
+{
+    auto pool = static_cast<DOS::DosQQmlComponentPool *>(vptr);
+    return pool->acquire();
+}
+
+void dos_qqmlcomponentpool_release(::DosQQmlComponentPool *vptr, ::DosQObject *object)
+{
+    auto pool = static_cast<DOS::DosQQmlComponentPool *>(vptr);
+    pool->release(static_cast<QObject *>(object));
+}
+
+int dos_qqmlcomponentpool_available(const ::DosQQmlComponentPool *vptr)
+{
+    auto pool = static_cast<const DOS::DosQQmlComponentPool *>(vptr);
+    return pool->available();
+}
+
+void dos_qqmlcomponentpool_delete(::DosQQmlComponentPool *vptr)
+{
+    auto pool = static_cast<DOS::DosQQmlComponentPool *>(vptr);
+    delete pool;
+}
+
 
 ::DosQQuickImageProvider *dos_qquickimageprovider_create(RequestPixmapCallback callback)
 {
@@ -319,6 +502,16 @@ void dos_qqmlcontext_setcontextproperty(::DosQQmlContext *vptr, const char *name
     context->setContextProperty(QString::fromUtf8(name), *variant);
 }
 
+void dos_qqmlcontext_setcontextproperties(::DosQQmlContext *vptr, int count, const char **names, ::DosQVariant **values)
+{
+    auto context = static_cast<QQmlContext *>(vptr);
+    QVector<QQmlContext::PropertyPair> properties;
+    properties.reserve(count);
+    for (int i = 0; i < count; ++i)
+        properties.append({QString::fromUtf8(names[i]), *static_cast<QVariant *>(values[i])});
+    context->setContextProperties(properties);
+}
+
 ::DosQVariant *dos_qvariant_create()
 {
     return new QVariant();
@@ -524,7 +717,7 @@ void dos_qvariant_setArray(::DosQVariant *vptr, int size, ::DosQVariant **array)
 
 ::DosQMetaObject *dos_qobject_qmetaobject()
 {
-    return new DOS::DosIQMetaObjectHolder(std::make_shared<DOS::DosQObjectMetaObject>());
+    return new DOS::DosIQMetaObjectHolder(DOS::baseMetaObject(DOS::DosQMetaObjectBase::Object));
 }
 
 ::DosQObject *dos_qobject_create(void *dObjectPointer, ::DosQMetaObject *metaObject, ::DObjectCallback dObjectCallback)
@@ -694,6 +887,45 @@ void *dos_qmodelindex_internalPointer(DosQModelIndex *vptr)
     return index->internalPointer();
 }
 
+DosModelIndexValue dos_qmodelindex_to_value(const ::DosQModelIndex *vptr)
+{
+    auto index = static_cast<const QModelIndex *>(vptr);
+    return DOS::toModelIndexValue(*index);
+}
+
+void dos_qmodelindex_assign_value(::DosQModelIndex *l, DosModelIndexValue r)
+{
+    auto li = static_cast<QModelIndex *>(l);
+    *li = DOS::toModelIndex(r);
+}
+
+bool dos_qmodelindex_value_isValid(DosModelIndexValue index)
+{
+    return index.model && index.row >= 0 && index.column >= 0;
+}
+
+::DosQVariant *dos_qmodelindex_value_data(DosModelIndexValue index, int role)
+{
+    return new QVariant(DOS::toModelIndex(index).data(role));
+}
+
+DosModelIndexValue dos_qmodelindex_value_parent(DosModelIndexValue index)
+{
+    return DOS::toModelIndexValue(DOS::toModelIndex(index).parent());
+}
+
+DosModelIndexValue dos_qmodelindex_value_child(DosModelIndexValue index, int row, int column)
+{
+    const QModelIndex parent = DOS::toModelIndex(index);
+    auto model = parent.model();
+    return DOS::toModelIndexValue(model ? model->index(row, column, parent) : QModelIndex());
+}
+
+DosModelIndexValue dos_qmodelindex_value_sibling(DosModelIndexValue index, int row, int column)
+{
+    return DOS::toModelIndexValue(DOS::toModelIndex(index).sibling(row, column));
+}
+
 ::DosQHashIntQByteArray *dos_qhash_int_qbytearray_create()
 {
     return new QHash<int, QByteArray>();
@@ -757,11 +989,11 @@ bool dos_qurl_isValid(const ::DosQUrl *vptr)
     auto data = superClassHolder->data();
     Q_ASSERT(data);
 
-    auto metaObject = std::make_shared<DOS::DosQMetaObject>(data,
-                                                            QString::fromUtf8(className),
-                                                            DOS::toVector(*signalDefinitions),
-                                                            DOS::toVector(*slotDefinitions),
-                                                            DOS::toVector(*propertyDefinitions));
+    auto metaObject = DOS::DosQMetaObjectCache::instance().metaObject(data,
+                                                                      className,
+                                                                      *signalDefinitions,
+                                                                      *slotDefinitions,
+                                                                      *propertyDefinitions);
     return new DOS::DosIQMetaObjectHolder(std::move(metaObject));
 }
 
@@ -771,6 +1003,60 @@ void dos_qmetaobject_delete(::DosQMetaObject *vptr)
     delete factory;
 }
 
+void dos_qmetaobject_cache_statistics(int *hits, int *misses)
+{
+    const DOS::DosQMetaObjectCache &cache = DOS::DosQMetaObjectCache::instance();
+    if (hits)
+        *hits = cache.hits();
+    if (misses)
+        *misses = cache.misses();
+}
+
+bool dos_qmetaobject_create_batch(int count, const ::DosQMetaObjectDescriptor *descriptors, ::DosQMetaObject **result)
+{
+    const std::vector<DOS::DosIQMetaObjectPtr> data = DOS::DosQMetaObjectCache::instance().metaObjects(descriptors, count);
+    if (data.size() != static_cast<size_t>(count))
+        return false;
+    for (int i = 0; i < count; ++i)
+        result[i] = new DOS::DosIQMetaObjectHolder(data[static_cast<size_t>(i)]);
+    return true;
+}
+
+char *dos_qmetaobject_serialize(::DosQMetaObject **metaObjects, int count, int *size)
+{
+    if (!size || count < 0 || (count > 0 && !metaObjects))
+        return nullptr;
+    *size = 0;
+
+    std::vector<DOS::DosIQMetaObjectPtr> data;
+    data.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        if (!metaObjects[i])
+            return nullptr;
+        data.push_back(static_cast<DOS::DosIQMetaObjectHolder *>(metaObjects[i])->data());
+    }
+
+    const QByteArray table = DOS::serializeMetaObjects(data);
+    *size = table.size();
+    if (table.isEmpty())
+        return nullptr;
+    auto result = new char[static_cast<size_t>(table.size())];
+    std::copy(table.constBegin(), table.constEnd(), result);
+    return result;
+}
+
+bool dos_qmetaobject_create_many(const char *table, int size, int count, ::DosQMetaObject **result)
+{
+    if (!table || size < 0 || count < 0 || (count > 0 && !result))
+        return false;
+    const std::vector<DOS::DosIQMetaObjectPtr> data = DOS::deserializeMetaObjects(QByteArray::fromRawData(table, size), count);
+    if (data.size() != static_cast<size_t>(count))
+        return false;
+    for (int i = 0; i < count; ++i)
+        result[i] = new DOS::DosIQMetaObjectHolder(data[static_cast<size_t>(i)]);
+    return true;
+}
+
 bool dos_qmetaobject_invoke_method(DosQObject *context, DosQMetaObjectInvokeMethodCallback callback, void *callbackData, DosQtConnectionType connection_type)
 {
     return QMetaObject::invokeMethod(static_cast<QObject*>(context), [callback, callbackData] {
@@ -780,7 +1066,7 @@ bool dos_qmetaobject_invoke_method(DosQObject *context, DosQMetaObjectInvokeMeth
 
 ::DosQMetaObject *dos_qabstracttablemodel_qmetaobject()
 {
-    return new DOS::DosIQMetaObjectHolder(std::make_shared<DOS::DosQAbstractTableModelMetaObject>());
+    return new DOS::DosIQMetaObjectHolder(DOS::baseMetaObject(DOS::DosQMetaObjectBase::TableModel));
 }
 
 ::DosQAbstractListModel *dos_qabstracttablemodel_create(void *dObjectPointer,
@@ -813,7 +1099,7 @@ DosQModelIndex *dos_qabstracttablemodel_parent(DosQAbstractTableModel *, DosQMod
 
 ::DosQMetaObject *dos_qabstractlistmodel_qmetaobject()
 {
-    return new DOS::DosIQMetaObjectHolder(std::make_shared<DOS::DosQAbstractListModelMetaObject>());
+    return new DOS::DosIQMetaObjectHolder(DOS::baseMetaObject(DOS::DosQMetaObjectBase::ListModel));
 }
 
 ::DosQAbstractListModel *dos_qabstractlistmodel_create(void *dObjectPointer,
@@ -852,7 +1138,7 @@ int dos_qabstractlistmodel_columnCount(DosQAbstractListModel *, DosQModelIndex *
 
 ::DosQMetaObject *dos_qabstractitemmodel_qmetaobject()
 {
-    return new DOS::DosIQMetaObjectHolder(std::make_shared<DOS::DosQAbstractItemModelMetaObject>());
+    return new DOS::DosIQMetaObjectHolder(DOS::baseMetaObject(DOS::DosQMetaObjectBase::ItemModel));
 }
 
 ::DosQAbstractItemModel *dos_qabstractitemmodel_create(void *dObjectPointer,
@@ -871,75 +1157,95 @@ int dos_qabstractlistmodel_columnCount(DosQAbstractListModel *, DosQModelIndex *
 
 void dos_qabstractitemmodel_beginInsertRows(::DosQAbstractItemModel *vptr, ::DosQModelIndex *parentIndex, int first, int last)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     auto index = static_cast<QModelIndex *>(parentIndex);
     model->publicBeginInsertRows(*index, first, last);
 }
 
 void dos_qabstractitemmodel_endInsertRows(::DosQAbstractItemModel *vptr)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     model->publicEndInsertRows();
 }
 
 void dos_qabstractitemmodel_beginRemoveRows(::DosQAbstractItemModel *vptr, ::DosQModelIndex *parentIndex, int first, int last)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     auto index = static_cast<QModelIndex *>(parentIndex);
     model->publicBeginRemoveRows(*index, first, last);
 }
 
 void dos_qabstractitemmodel_endRemoveRows(::DosQAbstractItemModel *vptr)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     model->publicEndRemoveRows();
 }
 
 void dos_qabstractitemmodel_beginInsertColumns(::DosQAbstractItemModel *vptr, ::DosQModelIndex *parentIndex, int first, int last)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     auto index = static_cast<QModelIndex *>(parentIndex);
     model->publicBeginInsertColumns(*index, first, last);
 }
 
 void dos_qabstractitemmodel_endInsertColumns(::DosQAbstractItemModel *vptr)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     model->publicEndInsertColumns();
 }
 
 void dos_qabstractitemmodel_beginRemoveColumns(::DosQAbstractItemModel *vptr, ::DosQModelIndex *parentIndex, int first, int last)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     auto index = static_cast<QModelIndex *>(parentIndex);
     model->publicBeginRemoveColumns(*index, first, last);
 }
 
 void dos_qabstractitemmodel_endRemoveColumns(::DosQAbstractItemModel *vptr)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     model->publicEndRemoveColumns();
 }
 
+bool dos_qabstractitemmodel_beginMoveRows(::DosQAbstractItemModel *vptr, ::DosQModelIndex *sourceParent, int first, int last,
+                                          ::DosQModelIndex *destinationParent, int destinationChild)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    auto sourceIndex = static_cast<QModelIndex *>(sourceParent);
+    auto destinationIndex = static_cast<QModelIndex *>(destinationParent);
+    return model->publicBeginMoveRows(*sourceIndex, first, last, *destinationIndex, destinationChild);
+}
+
+void dos_qabstractitemmodel_endMoveRows(::DosQAbstractItemModel *vptr)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->publicEndMoveRows();
+}
+
+bool dos_qabstractitemmodel_beginMoveColumns(::DosQAbstractItemModel *vptr, ::DosQModelIndex *sourceParent, int first, int last,
+                                             ::DosQModelIndex *destinationParent, int destinationChild)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    auto sourceIndex = static_cast<QModelIndex *>(sourceParent);
+    auto destinationIndex = static_cast<QModelIndex *>(destinationParent);
+    return model->publicBeginMoveColumns(*sourceIndex, first, last, *destinationIndex, destinationChild);
+}
+
+void dos_qabstractitemmodel_endMoveColumns(::DosQAbstractItemModel *vptr)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->publicEndMoveColumns();
+}
+
 void dos_qabstractitemmodel_beginResetModel(::DosQAbstractItemModel *vptr)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     model->publicBeginResetModel();
 }
 
 void dos_qabstractitemmodel_endResetModel(::DosQAbstractItemModel *vptr)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     model->publicEndResetModel();
 }
 
@@ -949,8 +1255,7 @@ void dos_qabstractitemmodel_dataChanged(::DosQAbstractItemModel *vptr,
                                         int *rolesArrayPtr,
                                         int rolesArrayLength)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     auto topLeft = static_cast<const QModelIndex *>(topLeftIndex);
     auto bottomRight = static_cast<const QModelIndex *>(bottomRightIndex);
     QVector<int> roles;
@@ -961,11 +1266,15 @@ void dos_qabstractitemmodel_dataChanged(::DosQAbstractItemModel *vptr,
 
 DosQModelIndex *dos_qabstractitemmodel_createIndex(::DosQAbstractItemModel *vptr, int row, int column, void *data)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     return new QModelIndex(model->publicCreateIndex(row, column, data));
 }
 
+DosModelIndexValue dos_qabstractitemmodel_createIndexValue(::DosQAbstractItemModel *vptr, int row, int column, uintptr_t internalId)
+{
+    return DosModelIndexValue {row, column, internalId, vptr};
+}
+
 bool dos_qabstractitemmodel_setData(DosQAbstractItemModel *vptr, DosQModelIndex *dosIndex, DosQVariant *dosValue, int role)
 {
     auto object = static_cast<QObject *>(vptr);
@@ -1009,8 +1318,7 @@ bool dos_qabstractitemmodel_hasChildren(DosQAbstractItemModel *vptr, DosQModelIn
 
 bool dos_qabstractitemmodel_hasIndex(DosQAbstractItemModel *vptr, int row, int column, DosQModelIndex *dosParentIndex)
 {
-    auto object = static_cast<QObject *>(vptr);
-    auto model = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
     auto index = static_cast<QModelIndex *>(dosParentIndex);
     return model->hasIndex(row, column, *index);
 }
@@ -1031,36 +1339,387 @@ void dos_qabstractitemmodel_fetchMore(DosQAbstractItemModel *vptr, DosQModelInde
     model->QAbstractItemModel::fetchMore(*parentIndex);
 }
 
-int dos_qdeclarative_qmlregistertype(const ::QmlRegisterType *cArgs)
+void dos_qabstractitemmodel_fetchComplete(DosQAbstractItemModel *vptr, const DosQModelIndex *parent, int count)
 {
-    auto holder = static_cast<DOS::DosIQMetaObjectHolder *>(cArgs->staticMetaObject);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    auto parentIndex = static_cast<const QModelIndex *>(parent);
+    model->fetchComplete(*parentIndex, count);
+}
 
-    DOS::QmlRegisterType args;
-    args.major = cArgs->major;
-    args.minor = cArgs->minor;
-    args.uri = cArgs->uri;
-    args.qml = cArgs->qml;
-    args.staticMetaObject = holder->data();
-    args.createDObject = cArgs->createDObject;
-    args.deleteDObject = cArgs->deleteDObject;
+void dos_qabstractitemmodel_queueDataChanged(DosQAbstractItemModel *vptr, int row, int column,
+                                             const int *roles, int rolesCount)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->queueDataChanged(row, column, roles, rolesCount);
+}
 
-    return DOS::dosQmlRegisterType(std::move(args));
+void dos_qabstractitemmodel_flushDataChanged(DosQAbstractItemModel *vptr)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->flushDataChanged();
 }
 
-int dos_qdeclarative_qmlregistersingletontype(const ::QmlRegisterType *cArgs)
+void dos_qabstractitemmodel_setFetchRangeCallback(DosQAbstractItemModel *vptr, ::FetchRangeCallback callback)
 {
-    auto holder = static_cast<DOS::DosIQMetaObjectHolder *>(cArgs->staticMetaObject);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->setFetchRangeCallback(callback);
+}
 
-    DOS::QmlRegisterType args;
-    args.major = cArgs->major;
-    args.minor = cArgs->minor;
-    args.uri = cArgs->uri;
-    args.qml = cArgs->qml;
-    args.staticMetaObject = holder->data();
-    args.createDObject = cArgs->createDObject;
-    args.deleteDObject = cArgs->deleteDObject;
+void dos_qabstractitemmodel_setMoveRowsCallback(DosQAbstractItemModel *vptr, ::MoveRowsCallback callback)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->setMoveRowsCallback(callback);
+}
+
+void dos_qabstractitemmodel_setValueCallbacks(DosQAbstractItemModel *vptr, const ::DosQAbstractItemModelValueCallbacks *callbacks)
+{
+    // Copy only the callbacks known by the caller, the ones appended later stay null
+    ::DosQAbstractItemModelValueCallbacks copy = {};
+    const int size = std::min(std::max(callbacks->size, 0), static_cast<int>(sizeof(copy)));
+    std::memcpy(&copy, callbacks, static_cast<size_t>(size));
+    copy.size = sizeof(copy);
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->setValueCallbacks(copy);
+}
+
+void dos_qabstractitemmodel_setCommitFetchedRowsCallback(DosQAbstractItemModel *vptr, ::CommitFetchedRowsCallback callback)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->setCommitFetchedRowsCallback(callback);
+}
+
+void dos_qabstractitemmodel_setDataCacheBudget(DosQAbstractItemModel *vptr, int bytes)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->setDataCacheBudget(bytes);
+}
+
+void dos_qabstractitemmodel_setStaticData(DosQAbstractItemModel *vptr, int staticData)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->setStaticData(staticData);
+}
+
+void dos_qabstractitemmodel_invalidateRoleNames(DosQAbstractItemModel *vptr)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->invalidateRoleNames();
+}
+
+void dos_qabstractitemmodel_invalidateFlags(DosQAbstractItemModel *vptr)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->invalidateFlags();
+}
+
+void dos_qabstractitemmodel_invalidateHeaderData(DosQAbstractItemModel *vptr, int orientation, int first, int last)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->invalidateHeaderData(static_cast<Qt::Orientation>(orientation), first, last);
+}
+
+void dos_qabstractitemmodel_applySnapshot(DosQAbstractItemModel *vptr,
+                                          const unsigned long long *keys,
+                                          const unsigned long long *hashes,
+                                          int count)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    std::vector<quint64> newKeys(keys, keys + count);
+    std::vector<quint64> newHashes;
+    if (hashes)
+        newHashes.assign(hashes, hashes + count);
+    model->applySnapshot(std::move(newKeys), std::move(newHashes));
+}
+
+void dos_qabstractitemmodel_enableTree(::DosQAbstractItemModel *vptr, int columnCount)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->enableTree(columnCount);
+}
+
+bool dos_qabstractitemmodel_treeInsert(::DosQAbstractItemModel *vptr, const ::DosQModelIndex *parent,
+                                       int row, const uintptr_t *payloads, int count)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    auto index = static_cast<const QModelIndex *>(parent);
+    std::vector<quintptr> nodes(payloads, payloads + (count > 0 ? count : 0));
+    return model->treeInsert(*index, row, nodes.data(), count);
+}
+
+bool dos_qabstractitemmodel_treeRemove(::DosQAbstractItemModel *vptr, const ::DosQModelIndex *parent, int row, int count)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    auto index = static_cast<const QModelIndex *>(parent);
+    return model->treeRemove(*index, row, count);
+}
+
+::DosQModelIndex *dos_qabstractitemmodel_treeIndex(::DosQAbstractItemModel *vptr, uintptr_t payload, int column)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    return new QModelIndex(model->treeIndex(payload, column));
+}
+
+void dos_qabstractitemmodel_treeClear(::DosQAbstractItemModel *vptr)
+{
+    auto model = DOS::toModelImpl(static_cast<QObject *>(vptr));
+    model->treeClear();
+}
+
+::DosQColumnarModel *dos_qcolumnarmodel_create(void *dObjectPointer,
+                                               ::DosQMetaObject *metaObjectPointer,
+                                               ::DObjectCallback dObjectCallback,
+                                               int roleCount,
+                                               const int *roleTypes,
+                                               const char **roleNames)
+{
+    std::vector<std::unique_ptr<DOS::DosQColumnBuffer>> columns;
+    std::vector<QByteArray> names;
+    for (int i = 0; i < roleCount; ++i) {
+        auto column = DOS::DosQColumnBuffer::create(roleTypes[i]);
+        if (!column)
+            return nullptr;
+        columns.push_back(std::move(column));
+        names.emplace_back(roleNames[i]);
+    }
+
+    auto metaObjectHolder = static_cast<DOS::DosIQMetaObjectHolder *>(metaObjectPointer);
+    auto model = new DOS::DosQColumnarModel(dObjectPointer,
+                                            metaObjectHolder->data(),
+                                            dObjectCallback,
+                                            std::move(columns),
+                                            names);
+    QQmlEngine::setObjectOwnership(model, QQmlEngine::CppOwnership);
+    return static_cast<QObject *>(model);
+}
 
-    return DOS::dosQmlRegisterSingletonType(std::move(args));
+bool dos_qcolumnarmodel_append(::DosQColumnarModel *vptr, int count, const void **columns)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    return model->insertRange(model->rowCount(), count, columns);
+}
+
+bool dos_qcolumnarmodel_update_range(::DosQColumnarModel *vptr, int row, int count, const void **columns)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    return model->updateRange(row, count, columns);
+}
+
+bool dos_qcolumnarmodel_remove_range(::DosQColumnarModel *vptr, int row, int count)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    return model->removeRange(row, count);
+}
+
+void dos_qcolumnarmodel_clear(::DosQColumnarModel *vptr)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    model->clear();
+}
+
+void dos_qcolumnarmodel_journal_insert(::DosQColumnarModel *vptr, int row, int count, const void **columns)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    model->journalInsert(row, count, columns);
+}
+
+void dos_qcolumnarmodel_journal_update(::DosQColumnarModel *vptr, int row, int count, const void **columns)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    model->journalUpdate(row, count, columns);
+}
+
+void dos_qcolumnarmodel_journal_remove(::DosQColumnarModel *vptr, int row, int count)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    model->journalRemove(row, count);
+}
+
+void dos_qcolumnarmodel_journal_move(::DosQColumnarModel *vptr, int row, int count, int destination)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    model->journalMove(row, count, destination);
+}
+
+void dos_qcolumnarmodel_journal_replay(::DosQColumnarModel *vptr)
+{
+    auto model = toItemModel<DOS::DosQColumnarModel>(vptr);
+    model->replayJournal();
+}
+
+::DosQRingBufferModel *dos_qringbuffermodel_create(void *dObjectPointer,
+                                                   ::DosQMetaObject *metaObjectPointer,
+                                                   ::DObjectCallback dObjectCallback,
+                                                   int capacity,
+                                                   int roleCount,
+                                                   const int *roleTypes,
+                                                   const char **roleNames)
+{
+    if (capacity <= 0)
+        return nullptr;
+
+    std::vector<int> types;
+    std::vector<QByteArray> names;
+    for (int i = 0; i < roleCount; ++i) {
+        if (!DOS::DosQColumnBuffer::create(roleTypes[i]))
+            return nullptr;
+        types.push_back(roleTypes[i]);
+        names.emplace_back(roleNames[i]);
+    }
+
+    auto metaObjectHolder = static_cast<DOS::DosIQMetaObjectHolder *>(metaObjectPointer);
+    auto model = new DOS::DosQRingBufferModel(dObjectPointer,
+                                              metaObjectHolder->data(),
+                                              dObjectCallback,
+                                              capacity,
+                                              types,
+                                              names);
+    QQmlEngine::setObjectOwnership(model, QQmlEngine::CppOwnership);
+    return static_cast<QObject *>(model);
+}
+
+void dos_qringbuffermodel_append(::DosQRingBufferModel *vptr, int count, const void **columns)
+{
+    auto model = toItemModel<DOS::DosQRingBufferModel>(vptr);
+    model->append(count, columns);
+}
+
+void dos_qringbuffermodel_flush(::DosQRingBufferModel *vptr)
+{
+    auto model = toItemModel<DOS::DosQRingBufferModel>(vptr);
+    model->publish();
+}
+
+void dos_qringbuffermodel_clear(::DosQRingBufferModel *vptr)
+{
+    auto model = toItemModel<DOS::DosQRingBufferModel>(vptr);
+    model->clear();
+}
+
+::DosQMappedFileModel *dos_qmappedfilemodel_create(void *dObjectPointer,
+                                                   ::DosQMetaObject *metaObjectPointer,
+                                                   ::DObjectCallback dObjectCallback,
+                                                   const char *dataPath,
+                                                   const char *indexPath,
+                                                   int headerSize,
+                                                   int recordSize,
+                                                   int fieldCount,
+                                                   const ::DosMappedFieldDefinition *fields)
+{
+    std::vector<::DosMappedFieldDefinition> definitions;
+    for (int i = 0; i < fieldCount; ++i) {
+        if (fields[i].type < DosMappedFieldInt8 || fields[i].type > DosMappedFieldUtf8)
+            return nullptr;
+        definitions.push_back(fields[i]);
+    }
+
+    auto metaObjectHolder = static_cast<DOS::DosIQMetaObjectHolder *>(metaObjectPointer);
+    auto model = new DOS::DosQMappedFileModel(dObjectPointer,
+                                              metaObjectHolder->data(),
+                                              dObjectCallback,
+                                              QString::fromUtf8(dataPath),
+                                              indexPath ? QString::fromUtf8(indexPath) : QString(),
+                                              headerSize,
+                                              recordSize,
+                                              definitions);
+    if (!model->isOpen()) {
+        delete model;
+        return nullptr;
+    }
+    QQmlEngine::setObjectOwnership(model, QQmlEngine::CppOwnership);
+    return static_cast<QObject *>(model);
+}
+
+bool dos_qmappedfilemodel_refresh(::DosQMappedFileModel *vptr)
+{
+    auto model = toItemModel<DOS::DosQMappedFileModel>(vptr);
+    return model->refresh();
+}
+
+::DosQSortFilterProxyModel *dos_qsortfilterproxymodel_create()
+{
+    auto model = new DOS::DosQSortFilterProxyModel();
+    QQmlEngine::setObjectOwnership(model, QQmlEngine::CppOwnership);
+    return static_cast<QObject *>(model);
+}
+
+void dos_qsortfilterproxymodel_setSourceModel(::DosQSortFilterProxyModel *vptr, ::DosQAbstractItemModel *sourceModel)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->setSourceModel(qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(sourceModel)));
+}
+
+void dos_qsortfilterproxymodel_setSortRole(::DosQSortFilterProxyModel *vptr, int role)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->setSortRole(role);
+}
+
+void dos_qsortfilterproxymodel_sort(::DosQSortFilterProxyModel *vptr, int column, int order)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->sort(column, static_cast<Qt::SortOrder>(order));
+}
+
+void dos_qsortfilterproxymodel_setDynamicSortFilter(::DosQSortFilterProxyModel *vptr, bool enable)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->setDynamicSortFilter(enable);
+}
+
+void dos_qsortfilterproxymodel_setFilterRole(::DosQSortFilterProxyModel *vptr, int role)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->setFilterRole(role);
+}
+
+void dos_qsortfilterproxymodel_setFilterKeyColumn(::DosQSortFilterProxyModel *vptr, int column)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->setFilterKeyColumn(column);
+}
+
+void dos_qsortfilterproxymodel_setFilterCaseSensitive(::DosQSortFilterProxyModel *vptr, bool caseSensitive)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->setFilterCaseSensitivity(caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+}
+
+void dos_qsortfilterproxymodel_setFilterFixedString(::DosQSortFilterProxyModel *vptr, const char *filter)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    model->setFilterString(filter ? QString::fromUtf8(filter) : QString());
+}
+
+::DosQModelIndex *dos_qsortfilterproxymodel_mapToSource(::DosQSortFilterProxyModel *vptr, const ::DosQModelIndex *proxyIndex)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    auto index = static_cast<const QModelIndex *>(proxyIndex);
+    return new QModelIndex(model->mapToSource(*index));
+}
+
+::DosQModelIndex *dos_qsortfilterproxymodel_mapFromSource(::DosQSortFilterProxyModel *vptr, const ::DosQModelIndex *sourceIndex)
+{
+    auto model = static_cast<DOS::DosQSortFilterProxyModel *>(static_cast<QObject *>(vptr));
+    auto index = static_cast<const QModelIndex *>(sourceIndex);
+    return new QModelIndex(model->mapFromSource(*index));
+}
+
+int dos_qdeclarative_qmlregistertype(const ::QmlRegisterType *cArgs)
+{
+    return DOS::dosQmlRegisterType(toQmlRegisterType(cArgs));
+}
+
+int dos_qdeclarative_qmlregistersingletontype(const ::QmlRegisterType *cArgs)
+{
+    return dos_qdeclarative_qmlregistersingletontype_with_mode(cArgs, DosQmlSingletonModeLazy, nullptr);
+}
+
+int dos_qdeclarative_qmlregistersingletontype_with_mode(const ::QmlRegisterType *cArgs, int mode,
+                                                        ::PrepareDObject prepareDObject)
+{
+    if (mode < DosQmlSingletonModeLazy || mode > DosQmlSingletonModePreloaded)
+        return -1;
+    return DOS::dosQmlRegisterSingletonType(toQmlRegisterType(cArgs), static_cast<DosQmlSingletonMode>(mode), prepareDObject);
 }
 
 void dos_qquickstyle_set_style(const char *style)
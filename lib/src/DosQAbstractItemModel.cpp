@@ -19,9 +19,19 @@
 
 #include "DOtherSide/DosQAbstractItemModel.h"
 #include "DOtherSide/DosQObjectImpl.h"
+#include "DOtherSide/DosQModelDiff.h"
+#include "DOtherSide/DosQModelIndexValue.h"
+
+// std
+#include <algorithm>
+#include <type_traits>
 
 namespace {
 
+const int FetchRangeBlockSize = 64;
+
+const int FetchedRowsChunkSize = 256;
+
 template<class T>
 DOS::DosQObjectImpl::ParentMetaCall createParentMetaCall(DOS::DosQAbstractGenericModel<T> *parent)
 {
@@ -44,6 +54,13 @@ DosQAbstractGenericModel<T>::DosQAbstractGenericModel(void *modelObject,
     , m_callbacks(callbacks)
 {}
 
+template<class T>
+DosQAbstractGenericModel<T>::DosQAbstractGenericModel(void *modelObject,
+                                                      DosIQMetaObjectPtr metaObject,
+                                                      DObjectCallback dObjectCallback)
+    : DosQAbstractGenericModel(modelObject, std::move(metaObject), dObjectCallback, DosQAbstractItemModelCallbacks())
+{}
+
 template<class T>
 bool DosQAbstractGenericModel<T>::emitSignal(QObject *emitter, const QString &name, const std::vector<QVariant> &argumentsValues)
 {
@@ -65,27 +82,59 @@ int DosQAbstractGenericModel<T>::qt_metacall(QMetaObject::Call call, int index,
     return m_impl->qt_metacall(call, index, args);
 }
 
+template<class T>
+void *DosQAbstractGenericModel<T>::qt_metacast(const char *className)
+{
+    if (isModelImplInterface(className))
+        return static_cast<DosIQAbstractItemModelImpl *>(this);
+    return T::qt_metacast(className);
+}
+
 template<class T>
 int DosQAbstractGenericModel<T>::rowCount(const QModelIndex &parent) const
 {
-    int result;
-    m_callbacks.rowCount(m_modelObject, &parent, &result);
-    return result;
+    if (m_tree) {
+        const int node = parent.column() > 0 ? static_cast<int>(DosQModelTree::NoNode) : treeNode(parent);
+        return node == DosQModelTree::NoNode ? 0 : m_tree->childCount(node);
+    }
+    if (m_snapshotReplay && !parent.isValid())
+        return static_cast<int>(m_snapshotRows.size());
+    return bindingRowCount(parent);
 }
 
 template<class T>
 int DosQAbstractGenericModel<T>::columnCount(const QModelIndex &parent) const
 {
-    int result;
-    m_callbacks.columnCount(m_modelObject, &parent, &result);
-    return result;
+    if (m_tree)
+        return m_treeColumnCount;
+    return bindingColumnCount(parent);
 }
 
 template<class T>
 QVariant DosQAbstractGenericModel<T>::data(const QModelIndex &index, int role) const
 {
+    if (m_snapshotReplay && index.isValid()) {
+        const QModelIndex current = snapshotIndex(index);
+        return current.isValid() ? bindingData(current, role) : QVariant();
+    }
+
+    if (!index.isValid() || !isDataCacheActive())
+        return bindingData(index, role);
+
     QVariant result;
-    m_callbacks.data(m_modelObject, &index, role, &result);
+
+    const DosQModelDataCacheKey key {index.row(), index.column(), cacheId(index), role};
+    if (m_dataCache.lookup(key, &result))
+        return result;
+
+    if (canFetchRange()) {
+        fetchRange(index, role);
+        if (m_dataCache.lookup(key, &result))
+            return result;
+    }
+
+    result = bindingData(index, role);
+    m_dataCache.insert(key, result);
     return result;
 }
 
@@ -93,15 +142,46 @@ template<class T>
 bool DosQAbstractGenericModel<T>::setData(const QModelIndex &index, const QVariant &value, int role)
 {
     bool result = false;
-    m_callbacks.setData(m_modelObject, &index, &value, role, &result);
+    if (m_valueCallbacks.setData)
+        m_valueCallbacks.setData(m_modelObject, toModelIndexValue(index), &value, role, &result);
+    else if (m_callbacks.setData)
+        m_callbacks.setData(m_modelObject, &index, &value, role, &result);
+    return result;
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::moveRows(const QModelIndex &sourceParent, int sourceRow, int count,
+                                           const QModelIndex &destinationParent, int destinationChild)
+{
+    if (!m_moveRows)
+        return T::moveRows(sourceParent, sourceRow, count, destinationParent, destinationChild);
+    bool result = false;
+    m_moveRows(m_modelObject, &sourceParent, sourceRow, count, &destinationParent, destinationChild, &result);
     return result;
 }
 
 template<class T>
 Qt::ItemFlags DosQAbstractGenericModel<T>::flags(const QModelIndex &index) const
 {
+    const bool isStatic = (m_staticData & DosStaticFlags) && index.isValid();
+    if (isStatic) {
+        auto it = m_flags.constFind(index.column());
+        if (it != m_flags.constEnd())
+            return it.value();
+    }
+
     int result;
-    m_callbacks.flags(m_modelObject, &index, &result);
+    if (m_snapshotReplay && index.isValid()) {
+        const QModelIndex current = snapshotIndex(index);
+        if (!current.isValid())
+            return Qt::NoItemFlags;
+        result = bindingFlags(current);
+    } else {
+        result = bindingFlags(index);
+    }
+
+    if (isStatic)
+        m_flags.insert(index.column(), Qt::ItemFlags(result));
     return Qt::ItemFlags(result);
 }
 
@@ -109,26 +189,447 @@ template<class T>
 QVariant DosQAbstractGenericModel<T>::headerData(int section, Qt::Orientation orientation, int role) const
 {
     QVariant result;
-    m_callbacks.headerData(m_modelObject, section, orientation, role, &result);
+    if (!(m_staticData & DosStaticHeaderData)) {
+        if (m_callbacks.headerData)
+            m_callbacks.headerData(m_modelObject, section, orientation, role, &result);
+        return result;
+    }
+
+    QHash<QPair<int, int>, QVariant> &values = m_headerData[orientation == Qt::Horizontal ? 0 : 1];
+    const QPair<int, int> key(section, role);
+    auto it = values.constFind(key);
+    if (it != values.constEnd())
+        return it.value();
+
+    if (m_callbacks.headerData)
+        m_callbacks.headerData(m_modelObject, section, orientation, role, &result);
+    values.insert(key, result);
     return result;
 }
 
 template<class T>
 QModelIndex DosQAbstractGenericModel<T>::index(int row, int column, const QModelIndex &parent) const
 {
-    QModelIndex result;
-    m_callbacks.index(m_modelObject, row, column, &parent, &result);
-    return result;
+    if (m_tree) {
+        const bool validColumn = column >= 0 && column < m_treeColumnCount && parent.column() <= 0;
+        const int node = validColumn ? treeNode(parent) : static_cast<int>(DosQModelTree::NoNode);
+        const int child = node == DosQModelTree::NoNode ? node : m_tree->child(node, row);
+        return child == DosQModelTree::NoNode ? QModelIndex() : T::createIndex(row, column, m_tree->payload(child));
+    }
+
+    // The binding already holds the new rows thus during a snapshot replay
+    // indexes of the root are created against the intermediate rows
+    if (m_snapshotReplay && !parent.isValid()) {
+        if (!T::hasIndex(row, column, parent))
+            return QModelIndex();
+        const QModelIndex result = m_snapshotRows[row] >= 0 ? bindingIndex(m_snapshotRows[row], column, parent) : QModelIndex();
+        return T::createIndex(row, column, result.internalPointer());
+    }
+
+    return bindingIndex(row, column, parent);
 }
 
 template<class T>
 QModelIndex DosQAbstractGenericModel<T>::parent(const QModelIndex &child) const
 {
-    QModelIndex result;
-    m_callbacks.parent(m_modelObject, &child, &result);
+    if (m_tree) {
+        const int node = treeNode(child);
+        const int parent = node == DosQModelTree::NoNode || node == DosQModelTree::RootNode ? static_cast<int>(DosQModelTree::NoNode) : m_tree->parent(node);
+        if (parent == DosQModelTree::NoNode || parent == DosQModelTree::RootNode)
+            return QModelIndex();
+        return T::createIndex(m_tree->row(parent), 0, m_tree->payload(parent));
+    }
+
+    const QModelIndex result = bindingParent(child);
+    if (m_snapshotReplay && result.isValid() && !parent(result).isValid()) {
+        const auto it = std::find(m_snapshotRows.cbegin(), m_snapshotRows.cend(), result.row());
+        if (it == m_snapshotRows.cend())
+            return QModelIndex();
+        return T::createIndex(static_cast<int>(it - m_snapshotRows.cbegin()), result.column(), result.internalPointer());
+    }
+    return result;
+}
+
+template<class T>
+int DosQAbstractGenericModel<T>::bindingRowCount(const QModelIndex &parent) const
+{
+    int result = 0;
+    if (m_valueCallbacks.rowCount)
+        m_valueCallbacks.rowCount(m_modelObject, toModelIndexValue(parent), &result);
+    else if (m_callbacks.rowCount)
+        m_callbacks.rowCount(m_modelObject, &parent, &result);
+    return result;
+}
+
+template<class T>
+int DosQAbstractGenericModel<T>::bindingColumnCount(const QModelIndex &parent) const
+{
+    int result = 0;
+    if (m_valueCallbacks.columnCount)
+        m_valueCallbacks.columnCount(m_modelObject, toModelIndexValue(parent), &result);
+    else if (m_callbacks.columnCount)
+        m_callbacks.columnCount(m_modelObject, &parent, &result);
+    return result;
+}
+
+template<class T>
+QVariant DosQAbstractGenericModel<T>::bindingData(const QModelIndex &index, int role) const
+{
+    QVariant result;
+    if (m_valueCallbacks.data)
+        m_valueCallbacks.data(m_modelObject, toModelIndexValue(index), role, &result);
+    else if (m_callbacks.data)
+        m_callbacks.data(m_modelObject, &index, role, &result);
+    return result;
+}
+
+template<class T>
+int DosQAbstractGenericModel<T>::bindingFlags(const QModelIndex &index) const
+{
+    int result = 0;
+    if (m_valueCallbacks.flags)
+        m_valueCallbacks.flags(m_modelObject, toModelIndexValue(index), &result);
+    else if (m_callbacks.flags)
+        m_callbacks.flags(m_modelObject, &index, &result);
     return result;
 }
 
+template<class T>
+QModelIndex DosQAbstractGenericModel<T>::bindingIndex(int row, int column, const QModelIndex &parent) const
+{
+    if (!m_valueCallbacks.index) {
+        QModelIndex result;
+        if (m_callbacks.index)
+            m_callbacks.index(m_modelObject, row, column, &parent, &result);
+        return result;
+    }
+
+    DosModelIndexValue result = invalidModelIndexValue();
+    m_valueCallbacks.index(m_modelObject, row, column, toModelIndexValue(parent), &result);
+    return result.model ? T::createIndex(result.row, result.column, static_cast<quintptr>(result.internalId)) : QModelIndex();
+}
+
+template<class T>
+QModelIndex DosQAbstractGenericModel<T>::bindingParent(const QModelIndex &child) const
+{
+    if (!m_valueCallbacks.parent) {
+        QModelIndex result;
+        if (m_callbacks.parent)
+            m_callbacks.parent(m_modelObject, &child, &result);
+        return result;
+    }
+
+    DosModelIndexValue result = invalidModelIndexValue();
+    m_valueCallbacks.parent(m_modelObject, toModelIndexValue(child), &result);
+    return result.model ? T::createIndex(result.row, result.column, static_cast<quintptr>(result.internalId)) : QModelIndex();
+}
+
+template<class T>
+quintptr DosQAbstractGenericModel<T>::cacheId(const QModelIndex &index) const
+{
+    // Rows of list and table models are always children of the root index thus
+    // the row and column are enough for identifying them
+    return std::is_same<T, QAbstractItemModel>::value ? index.internalId() : 0;
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::canFetchRange() const
+{
+    return m_fetchRange && (!std::is_same<T, QAbstractItemModel>::value || m_tree);
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::fetchRange(const QModelIndex &index, int role) const
+{
+    const bool isTree = std::is_same<T, QAbstractItemModel>::value;
+    const QModelIndex parent = isTree ? index.parent() : QModelIndex();
+    const int column = index.column();
+    const int firstRow = index.row() - index.row() % FetchRangeBlockSize;
+    const int lastRow = std::min(firstRow + FetchRangeBlockSize, rowCount(parent)) - 1;
+    if (lastRow < firstRow)
+        return;
+
+    QVector<int> roles;
+    const QHash<int, QByteArray> names = roleNames();
+    for (auto it = names.cbegin(); it != names.cend(); ++it)
+        roles.push_back(it.key());
+    if (!roles.contains(role))
+        roles.push_back(role);
+    std::sort(roles.begin(), roles.end());
+
+    const int rolesCount = roles.size();
+    const int rowsCount = lastRow - firstRow + 1;
+    std::vector<QVariant> values(rowsCount * rolesCount);
+    std::vector<DosQVariant *> valuesPointers(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        valuesPointers[i] = &values[i];
+
+    m_fetchRange(m_modelObject, &parent, column, firstRow, lastRow, roles.constData(), rolesCount, valuesPointers.data());
+
+    for (int i = 0; i < rowsCount; ++i) {
+        const int row = firstRow + i;
+        // Only native trees get here thus creating the index doesn't call the binding
+        const quintptr id = isTree && row != index.row() ? cacheId(this->index(row, column, parent)) : cacheId(index);
+        for (int j = 0; j < rolesCount; ++j)
+            m_dataCache.insert(DosQModelDataCacheKey {row, column, id, roles[j]}, values[i * rolesCount + j]);
+    }
+}
+
+template<class T>
+QModelIndex DosQAbstractGenericModel<T>::snapshotIndex(const QModelIndex &index) const
+{
+    if (std::is_same<T, QAbstractItemModel>::value && parent(index).isValid())
+        return index;
+    const int row = m_snapshotRows[index.row()];
+    return row < 0 ? QModelIndex() : T::createIndex(row, index.column(), index.internalPointer());
+}
+
+template<class T>
+int DosQAbstractGenericModel<T>::treeNode(const QModelIndex &index) const
+{
+    return index.isValid() ? m_tree->node(index.internalId()) : static_cast<int>(DosQModelTree::RootNode);
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::isDataCacheActive() const
+{
+    return (m_dataCacheEnabled || canFetchRange()) && !m_dataCacheSuspended && !m_snapshotReplay;
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::suspendDataCache()
+{
+    m_dataCacheSuspended = true;
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::resumeDataCache()
+{
+    m_dataCacheSuspended = false;
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::setDataCacheBudget(int bytes)
+{
+    m_dataCacheEnabled = bytes > 0;
+    m_dataCache.clear();
+    m_dataCache.setBudget(m_dataCacheEnabled ? bytes : DosQModelDataCache::DefaultBudget);
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::setFetchRangeCallback(FetchRangeCallback callback)
+{
+    m_fetchRange = callback;
+    m_dataCache.clear();
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::setMoveRowsCallback(MoveRowsCallback callback)
+{
+    m_moveRows = callback;
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::setValueCallbacks(const DosQAbstractItemModelValueCallbacks &callbacks)
+{
+    m_valueCallbacks = callbacks;
+    m_dataCache.clear();
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::setCommitFetchedRowsCallback(CommitFetchedRowsCallback callback)
+{
+    m_commitFetchedRows = callback;
+}
+
+template<class T>
+QAbstractItemModel *DosQAbstractGenericModel<T>::itemModel()
+{
+    return this;
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::setStaticData(int staticData)
+{
+    m_staticData = staticData;
+    invalidateRoleNames();
+    invalidateFlags();
+    m_headerData[0].clear();
+    m_headerData[1].clear();
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::invalidateRoleNames()
+{
+    m_roleNamesStored = false;
+    m_roleNames.clear();
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::invalidateFlags()
+{
+    m_flags.clear();
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::invalidateHeaderData(Qt::Orientation orientation, int first, int last)
+{
+    QHash<QPair<int, int>, QVariant> &values = m_headerData[orientation == Qt::Horizontal ? 0 : 1];
+    for (auto it = values.begin(); it != values.end();) {
+        if (it.key().first >= first && it.key().first <= last)
+            it = values.erase(it);
+        else
+            ++it;
+    }
+    emit T::headerDataChanged(orientation, first, last);
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::applySnapshot(std::vector<quint64> keys, std::vector<quint64> hashes)
+{
+    flushDataChanged();
+
+    const DosQModelDiff diff(m_snapshotKeys, m_snapshotHashes, keys, hashes);
+    const bool reset = !m_hasSnapshot || diff.requiresReset();
+    m_snapshotKeys = std::move(keys);
+    m_snapshotHashes = std::move(hashes);
+    m_hasSnapshot = true;
+
+    if (reset) {
+        publicBeginResetModel();
+        publicEndResetModel();
+        return;
+    }
+
+    const QModelIndex root;
+    m_snapshotRows = diff.rowMap();
+    m_snapshotReplay = true;
+
+    for (const DosQModelDiffOperation &operation : diff.operations()) {
+        switch (operation.type) {
+        case DosQModelDiffOperation::Remove:
+            publicBeginRemoveRows(root, operation.first, operation.last);
+            m_snapshotRows.erase(m_snapshotRows.begin() + operation.first, m_snapshotRows.begin() + operation.last + 1);
+            publicEndRemoveRows();
+            break;
+        case DosQModelDiffOperation::Move: {
+            auto first = m_snapshotRows.begin() + operation.first;
+            auto last = m_snapshotRows.begin() + operation.last + 1;
+            auto destination = m_snapshotRows.begin() + operation.destination;
+            if (publicBeginMoveRows(root, operation.first, operation.last, root, operation.destination)) {
+                if (operation.destination < operation.first)
+                    std::rotate(destination, first, last);
+                else
+                    std::rotate(first, last, destination);
+                publicEndMoveRows();
+                break;
+            }
+
+            // The move was rejected thus the rows are removed and inserted back at their destination
+            const std::vector<int> moved(first, last);
+            publicBeginRemoveRows(root, operation.first, operation.last);
+            m_snapshotRows.erase(first, last);
+            publicEndRemoveRows();
+            const int count = static_cast<int>(moved.size());
+            const int target = operation.destination > operation.first ? operation.destination - count : operation.destination;
+            publicBeginInsertRows(root, target, target + count - 1);
+            m_snapshotRows.insert(m_snapshotRows.begin() + target, moved.begin(), moved.end());
+            publicEndInsertRows();
+            break;
+        }
+        case DosQModelDiffOperation::Layout: {
+            emit T::layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+            std::vector<int> sorted = m_snapshotRows;
+            std::sort(sorted.begin(), sorted.end());
+            QModelIndexList from;
+            QModelIndexList to;
+            for (const QModelIndex &index : T::persistentIndexList()) {
+                if (index.parent().isValid())
+                    continue;
+                from.push_back(index);
+                const auto row = std::lower_bound(sorted.begin(), sorted.end(), m_snapshotRows[index.row()]) - sorted.begin();
+                to.push_back(T::createIndex(static_cast<int>(row), index.column(), index.internalPointer()));
+            }
+            T::changePersistentIndexList(from, to);
+            m_snapshotRows = std::move(sorted);
+            m_dataCache.clear();
+            emit T::layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+            break;
+        }
+        case DosQModelDiffOperation::Insert:
+            publicBeginInsertRows(root, operation.first, operation.last);
+            for (int row = operation.first; row <= operation.last; ++row)
+                m_snapshotRows.insert(m_snapshotRows.begin() + row, row);
+            publicEndInsertRows();
+            break;
+        case DosQModelDiffOperation::Change:
+            publicDataChanged(index(operation.first, 0, root), index(operation.last, columnCount(root) - 1, root));
+            break;
+        }
+    }
+
+    m_snapshotReplay = false;
+    m_snapshotRows.clear();
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::enableTree(int columnCount)
+{
+    publicBeginResetModel();
+    m_tree.reset(new DosQModelTree());
+    m_treeColumnCount = columnCount;
+    publicEndResetModel();
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::treeInsert(const QModelIndex &parent, int row, const quintptr *payloads, int count)
+{
+    const int node = m_tree && parent.column() <= 0 ? treeNode(parent) : static_cast<int>(DosQModelTree::NoNode);
+    if (node == DosQModelTree::NoNode || !m_tree->canInsert(node, row, payloads, count))
+        return false;
+    if (count == 0)
+        return true;
+
+    publicBeginInsertRows(parent, row, row + count - 1);
+    m_tree->insert(node, row, payloads, count);
+    publicEndInsertRows();
+    return true;
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::treeRemove(const QModelIndex &parent, int row, int count)
+{
+    const int node = m_tree && parent.column() <= 0 ? treeNode(parent) : static_cast<int>(DosQModelTree::NoNode);
+    if (node == DosQModelTree::NoNode || row < 0 || count < 0 || row + count > m_tree->childCount(node))
+        return false;
+    if (count == 0)
+        return true;
+
+    publicBeginRemoveRows(parent, row, row + count - 1);
+    m_tree->remove(node, row, count);
+    publicEndRemoveRows();
+    return true;
+}
+
+template<class T>
+QModelIndex DosQAbstractGenericModel<T>::treeIndex(quintptr payload, int column) const
+{
+    const int node = m_tree ? m_tree->node(payload) : static_cast<int>(DosQModelTree::NoNode);
+    if (node == DosQModelTree::NoNode || column < 0 || column >= m_treeColumnCount)
+        return QModelIndex();
+    return T::createIndex(m_tree->row(node), column, payload);
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::treeClear()
+{
+    if (!m_tree)
+        return;
+    publicBeginResetModel();
+    m_tree->clear();
+    publicEndResetModel();
+}
+
 template<class T>
 void *DosQAbstractGenericModel<T>::modelObject()
 {
@@ -138,76 +639,190 @@ void *DosQAbstractGenericModel<T>::modelObject()
 template<class T>
 QHash<int, QByteArray> DosQAbstractGenericModel<T>::roleNames() const
 {
-    QHash<int, QByteArray> result;
-    m_callbacks.roleNames(m_modelObject, &result);
-    return result;
+    if (!(m_staticData & DosStaticRoleNames)) {
+        QHash<int, QByteArray> result;
+        if (m_callbacks.roleNames)
+            m_callbacks.roleNames(m_modelObject, &result);
+        return result;
+    }
+
+    if (!m_roleNamesStored) {
+        m_roleNames.clear();
+        if (m_callbacks.roleNames)
+            m_callbacks.roleNames(m_modelObject, &m_roleNames);
+        m_roleNamesStored = true;
+    }
+    return m_roleNames;
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicBeginInsertColumns(const QModelIndex &index, int first, int last)
 {
+    flushDataChanged();
+    suspendDataCache();
+    if (std::is_same<T, QAbstractItemModel>::value)
+        m_dataCache.clear();
+    else
+        m_dataCache.insertColumns(first, last - first + 1);
     T::beginInsertColumns(index, first, last);
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicEndInsertColumns()
 {
+    resumeDataCache();
     T::endInsertColumns();
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicBeginRemoveColumns(const QModelIndex &index, int first, int last)
 {
+    flushDataChanged();
+    suspendDataCache();
+    if (std::is_same<T, QAbstractItemModel>::value)
+        m_dataCache.clear();
+    else
+        m_dataCache.removeColumns(first, last - first + 1);
     T::beginRemoveColumns(index, first, last);
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicEndRemoveColumns()
 {
+    resumeDataCache();
     T::endRemoveColumns();
 }
+
 template<class T>
 void DosQAbstractGenericModel<T>::publicBeginInsertRows(const QModelIndex &index, int first, int last)
 {
+    flushDataChanged();
+    suspendDataCache();
+    if (std::is_same<T, QAbstractItemModel>::value)
+        m_dataCache.clear();
+    else
+        m_dataCache.insertRows(first, last - first + 1);
     T::beginInsertRows(index, first, last);
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicEndInsertRows()
 {
+    resumeDataCache();
     T::endInsertRows();
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicBeginRemoveRows(const QModelIndex &index, int first, int last)
 {
+    flushDataChanged();
+    suspendDataCache();
+    if (std::is_same<T, QAbstractItemModel>::value)
+        m_dataCache.clear();
+    else
+        m_dataCache.removeRows(first, last - first + 1);
     T::beginRemoveRows(index, first, last);
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicEndRemoveRows()
 {
+    resumeDataCache();
     T::endRemoveRows();
 }
 
+template<class T>
+bool DosQAbstractGenericModel<T>::publicBeginMoveRows(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                                                      const QModelIndex &destinationParent, int destinationChild)
+{
+    flushDataChanged();
+    if (!T::beginMoveRows(sourceParent, sourceFirst, sourceLast, destinationParent, destinationChild))
+        return false;
+    suspendDataCache();
+    if (std::is_same<T, QAbstractItemModel>::value)
+        m_dataCache.clear();
+    else
+        m_dataCache.moveRows(sourceFirst, sourceLast, destinationChild);
+    return true;
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::publicEndMoveRows()
+{
+    resumeDataCache();
+    T::endMoveRows();
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::publicBeginMoveColumns(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                                                         const QModelIndex &destinationParent, int destinationChild)
+{
+    flushDataChanged();
+    if (!T::beginMoveColumns(sourceParent, sourceFirst, sourceLast, destinationParent, destinationChild))
+        return false;
+    suspendDataCache();
+    if (std::is_same<T, QAbstractItemModel>::value)
+        m_dataCache.clear();
+    else
+        m_dataCache.moveColumns(sourceFirst, sourceLast, destinationChild);
+    return true;
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::publicEndMoveColumns()
+{
+    resumeDataCache();
+    T::endMoveColumns();
+}
+
 template<class T>
 void DosQAbstractGenericModel<T>::publicBeginResetModel()
 {
+    m_pendingDataChanged.clear();
+    m_pendingFetches.clear();
+    suspendDataCache();
+    m_dataCache.clear();
     T::beginResetModel();
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicEndResetModel()
 {
+    m_dataCache.clear();
+    resumeDataCache();
     T::endResetModel();
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::publicDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
+    // Rows of tree models are relative to their parent thus the rows are invalidated for every parent.
+    // Dropping whole rows costs as much as their count whatever the cache size
+    if (topLeft.isValid() && bottomRight.isValid())
+        m_dataCache.invalidateRows(topLeft.row(), bottomRight.row());
+    else
+        m_dataCache.clear();
     emit T::dataChanged(topLeft, bottomRight, roles);
 }
 
+template<class T>
+void DosQAbstractGenericModel<T>::queueDataChanged(int row, int column, const int *roles, int rolesCount)
+{
+    if (m_pendingDataChanged.isEmpty())
+        QMetaObject::invokeMethod(this, [this] { flushDataChanged(); }, Qt::QueuedConnection);
+    m_pendingDataChanged.add(row, column, roles, rolesCount);
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::flushDataChanged()
+{
+    if (m_pendingDataChanged.isEmpty())
+        return;
+    const QModelIndex root;
+    for (const DosQDataChangedBuffer::Range &range : m_pendingDataChanged.take())
+        publicDataChanged(index(range.firstRow, range.firstColumn, root), index(range.lastRow, range.lastColumn, root), range.roles);
+}
+
 template<class T>
 QModelIndex DosQAbstractGenericModel<T>::publicCreateIndex(int row, int column, void *data) const
 {
@@ -217,8 +832,13 @@ QModelIndex DosQAbstractGenericModel<T>::publicCreateIndex(int row, int column,
 template<class T>
 bool DosQAbstractGenericModel<T>::hasChildren(const QModelIndex &parent) const
 {
+    if (m_tree)
+        return rowCount(parent) > 0;
     bool result = false;
-    m_callbacks.hasChildren(m_modelObject, &parent, &result);
+    if (m_valueCallbacks.hasChildren)
+        m_valueCallbacks.hasChildren(m_modelObject, toModelIndexValue(parent), &result);
+    else if (m_callbacks.hasChildren)
+        m_callbacks.hasChildren(m_modelObject, &parent, &result);
     return result;
 }
 
@@ -231,15 +851,102 @@ bool DosQAbstractGenericModel<T>::hasIndex(int row, int column, const QModelInde
 template<class T>
 bool DosQAbstractGenericModel<T>::canFetchMore(const QModelIndex &parent) const
 {
+    if (isFetchAsync() && hasPendingFetch(parent))
+        return false;
     bool result = false;
-    m_callbacks.canFetchMore(m_modelObject, &parent, &result);
+    if (m_valueCallbacks.canFetchMore)
+        m_valueCallbacks.canFetchMore(m_modelObject, toModelIndexValue(parent), &result);
+    else if (m_callbacks.canFetchMore)
+        m_callbacks.canFetchMore(m_modelObject, &parent, &result);
     return result;
 }
 
 template<class T>
 void DosQAbstractGenericModel<T>::fetchMore(const QModelIndex &parent)
 {
-    m_callbacks.fetchMore(m_modelObject, &parent);
+    if (isFetchAsync()) {
+        if (hasPendingFetch(parent))
+            return;
+        m_pendingFetches.push_back(PendingFetch {QPersistentModelIndex(parent), parent, !parent.isValid(), 0, false});
+    }
+    if (m_valueCallbacks.fetchMore)
+        m_valueCallbacks.fetchMore(m_modelObject, toModelIndexValue(parent));
+    else if (m_callbacks.fetchMore)
+        m_callbacks.fetchMore(m_modelObject, &parent);
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::isFetchAsync() const
+{
+    return m_commitFetchedRows != nullptr;
+}
+
+template<class T>
+bool DosQAbstractGenericModel<T>::hasPendingFetch(const QModelIndex &parent) const
+{
+    return std::any_of(m_pendingFetches.begin(), m_pendingFetches.end(), [&parent](const PendingFetch &pending) {
+        return pending.matches(parent);
+    });
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::fetchComplete(const QModelIndex &parent, int count)
+{
+    QMetaObject::invokeMethod(this, [this, parent, count] { onFetchCompleted(parent, count); }, Qt::QueuedConnection);
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::onFetchCompleted(const QModelIndex &parent, int count)
+{
+    // The binding reports the parent it received in fetchMore() thus it's matched against the requested
+    // index and not against the current position of the parent
+    auto fetch = std::find_if(m_pendingFetches.begin(), m_pendingFetches.end(), [&parent](const PendingFetch &pending) {
+        return pending.requested == parent;
+    });
+    // Fetches started before a model reset aren't tracked anymore thus their rows are dropped
+    if (fetch == m_pendingFetches.end())
+        return;
+    fetch->remaining += std::max(count, 0);
+    fetch->completed = true;
+
+    if (!m_fetchInsertionScheduled)
+        insertFetchedRows();
+}
+
+template<class T>
+void DosQAbstractGenericModel<T>::insertFetchedRows()
+{
+    m_fetchInsertionScheduled = false;
+
+    auto fetch = std::find_if(m_pendingFetches.begin(), m_pendingFetches.end(), [](const PendingFetch &pending) {
+        return pending.completed;
+    });
+    if (fetch == m_pendingFetches.end())
+        return;
+
+    // The parent could have been removed while the rows were loading
+    const QModelIndex parent = fetch->parent;
+    const bool removed = !fetch->root && !parent.isValid();
+    const int count = removed ? 0 : std::min(fetch->remaining, FetchedRowsChunkSize);
+    fetch->remaining -= count;
+    if (removed || fetch->remaining <= 0)
+        m_pendingFetches.erase(fetch);
+
+    if (count > 0) {
+        const int first = rowCount(parent);
+        publicBeginInsertRows(parent, first, first + count - 1);
+        m_commitFetchedRows(m_modelObject, &parent, count);
+        publicEndInsertRows();
+    }
+
+    // Remaining rows are inserted on the next event loop iterations so that views can render in between
+    const bool hasCompletedFetches = std::any_of(m_pendingFetches.begin(), m_pendingFetches.end(), [](const PendingFetch &pending) {
+        return pending.completed;
+    });
+    if (hasCompletedFetches && !m_fetchInsertionScheduled) {
+        m_fetchInsertionScheduled = true;
+        QMetaObject::invokeMethod(this, [this] { insertFetchedRows(); }, Qt::QueuedConnection);
+    }
 }
 
 } // namespace DOS
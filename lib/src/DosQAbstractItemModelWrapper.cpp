@@ -0,0 +1,402 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQAbstractItemModelWrapper.h"
+
+namespace DOS {
+
+template<typename T>
+DosQAbstractItemModelWrapper<T>::DosQAbstractItemModelWrapper(const DosQmlTypeRegistration &registration, QObject *parent)
+    : T(parent)
+    , m_registration(registration)
+{
+    void *impl = nullptr;
+    m_registration.data.createDObject(m_registration.id, static_cast<QObject *>(this), &m_dObject, &impl);
+    m_impl = dynamic_cast<QAbstractItemModel *>(static_cast<QObject *>(impl));
+    m_dosImpl = toModelImpl(static_cast<QObject *>(impl));
+    QObject::connect(m_impl, &T::rowsAboutToBeInserted, this, &DosQAbstractItemModelWrapper<T>::beginInsertRows);
+    QObject::connect(m_impl, &T::rowsInserted, this, &DosQAbstractItemModelWrapper<T>::endInsertRows);
+    QObject::connect(m_impl, &T::rowsAboutToBeRemoved, this, &DosQAbstractItemModelWrapper<T>::beginRemoveRows);
+    QObject::connect(m_impl, &T::rowsRemoved, this, &DosQAbstractItemModelWrapper<T>::endRemoveRows);
+    QObject::connect(m_impl, &T::rowsAboutToBeMoved, this, &DosQAbstractItemModelWrapper<T>::beginMoveRows);
+    QObject::connect(m_impl, &T::rowsMoved, this, &DosQAbstractItemModelWrapper<T>::endMoveRows);
+    QObject::connect(m_impl, &T::columnsAboutToBeInserted, this, &DosQAbstractItemModelWrapper<T>::beginInsertColumns);
+    QObject::connect(m_impl, &T::columnsInserted, this, &DosQAbstractItemModelWrapper<T>::endInsertColumns);
+    QObject::connect(m_impl, &T::columnsAboutToBeRemoved, this, &DosQAbstractItemModelWrapper<T>::beginRemoveColumns);
+    QObject::connect(m_impl, &T::columnsRemoved, this, &DosQAbstractItemModelWrapper<T>::endRemoveColumns);
+    QObject::connect(m_impl, &T::columnsAboutToBeMoved, this, &DosQAbstractItemModelWrapper<T>::beginMoveColumns);
+    QObject::connect(m_impl, &T::columnsMoved, this, &DosQAbstractItemModelWrapper<T>::endMoveColumns);
+    QObject::connect(m_impl, &T::modelAboutToBeReset, this, &DosQAbstractItemModelWrapper<T>::beginResetModel);
+    QObject::connect(m_impl, &T::modelReset, this, &DosQAbstractItemModelWrapper<T>::endResetModel);
+    QObject::connect(m_impl, &T::dataChanged, this, &DosQAbstractItemModelWrapper<T>::dataChanged);
+    QObject::connect(m_impl, &T::headerDataChanged, this, &DosQAbstractItemModelWrapper<T>::headerDataChanged);
+    QObject::connect(m_impl, &T::layoutAboutToBeChanged, this, &DosQAbstractItemModelWrapper<T>::layoutAboutToBeChanged);
+    QObject::connect(m_impl, &T::layoutChanged, this, &DosQAbstractItemModelWrapper<T>::layoutChanged);
+    Q_ASSERT(m_dObject);
+    Q_ASSERT(m_impl);
+}
+
+template<typename T>
+DosQAbstractItemModelWrapper<T>::~DosQAbstractItemModelWrapper()
+{
+    m_registration.data.deleteDObject(m_registration.id, m_dObject);
+    m_dObject = nullptr;
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+template<typename T>
+const QMetaObject *DosQAbstractItemModelWrapper<T>::metaObject() const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->metaObject();
+}
+
+template<typename T>
+int DosQAbstractItemModelWrapper<T>::qt_metacall(QMetaObject::Call call, int index, void **args)
+{
+    Q_ASSERT(m_impl);
+    return m_impl->qt_metacall(call, index, args);
+}
+
+template<typename T>
+void *DosQAbstractItemModelWrapper<T>::qt_metacast(const char *className)
+{
+    // Hand out the wrapped implementation so that calls made through the C API
+    // skip the forwarding functions of this class
+    if (isModelImplInterface(className))
+        return m_dosImpl;
+    return T::qt_metacast(className);
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::emitSignal(QObject *, const QString &name, const std::vector<QVariant> &argumentsValues)
+{
+    Q_ASSERT(m_impl);
+    return m_dosImpl->emitSignal(this, name, argumentsValues);
+}
+
+template<typename T>
+int DosQAbstractItemModelWrapper<T>::rowCount(const QModelIndex &parent) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->rowCount(parent);
+}
+
+template<typename T>
+int DosQAbstractItemModelWrapper<T>::columnCount(const QModelIndex &parent) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->columnCount(parent);
+}
+
+template<typename T>
+QVariant DosQAbstractItemModelWrapper<T>::data(const QModelIndex &index, int role) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->data(index, role);
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    Q_ASSERT(m_impl);
+    return m_impl->setData(index, value, role);
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::moveRows(const QModelIndex &sourceParent, int sourceRow, int count,
+                                                     const QModelIndex &destinationParent, int destinationChild)
+{
+    Q_ASSERT(m_impl);
+    return m_impl->moveRows(sourceParent, sourceRow, count, destinationParent, destinationChild);
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::canFetchMore(const QModelIndex &parent) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->canFetchMore(parent);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::fetchMore(const QModelIndex &parent)
+{
+    Q_ASSERT(m_impl);
+    m_impl->fetchMore(parent);
+}
+
+template<typename T>
+Qt::ItemFlags DosQAbstractItemModelWrapper<T>::flags(const QModelIndex &index) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->flags(index);
+}
+
+template<typename T>
+QVariant DosQAbstractItemModelWrapper<T>::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->headerData(section, orientation, role);
+}
+
+template<typename T>
+QHash<int, QByteArray> DosQAbstractItemModelWrapper<T>::roleNames() const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->roleNames();
+}
+
+template<typename T>
+QModelIndex DosQAbstractItemModelWrapper<T>::index(int row, int column, const QModelIndex &parent) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->index(row, column, parent);
+}
+
+template<typename T>
+QModelIndex DosQAbstractItemModelWrapper<T>::parent(const QModelIndex &child) const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->parent(child);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicBeginInsertRows(const QModelIndex &index, int first, int last)
+{
+    m_dosImpl->publicBeginInsertRows(index, first, last);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicEndInsertRows()
+{
+    m_dosImpl->publicEndInsertRows();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicBeginRemoveRows(const QModelIndex &index, int first, int last)
+{
+    m_dosImpl->publicBeginRemoveRows(index, first, last);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicEndRemoveRows()
+{
+    m_dosImpl->publicEndRemoveRows();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicBeginInsertColumns(const QModelIndex &index, int first, int last)
+{
+    m_dosImpl->publicBeginInsertColumns(index, first, last);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicEndInsertColumns()
+{
+    m_dosImpl->publicEndInsertColumns();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicBeginRemoveColumns(const QModelIndex &index, int first, int last)
+{
+    m_dosImpl->publicBeginRemoveColumns(index, first, last);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicEndRemoveColumns()
+{
+    m_dosImpl->publicEndRemoveColumns();
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::publicBeginMoveRows(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                                                                const QModelIndex &destinationParent, int destinationChild)
+{
+    return m_dosImpl->publicBeginMoveRows(sourceParent, sourceFirst, sourceLast, destinationParent, destinationChild);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicEndMoveRows()
+{
+    m_dosImpl->publicEndMoveRows();
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::publicBeginMoveColumns(const QModelIndex &sourceParent, int sourceFirst, int sourceLast,
+                                                                   const QModelIndex &destinationParent, int destinationChild)
+{
+    return m_dosImpl->publicBeginMoveColumns(sourceParent, sourceFirst, sourceLast, destinationParent, destinationChild);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicEndMoveColumns()
+{
+    m_dosImpl->publicEndMoveColumns();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicBeginResetModel()
+{
+    m_dosImpl->publicBeginResetModel();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicEndResetModel()
+{
+    m_dosImpl->publicEndResetModel();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::publicDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    m_dosImpl->publicDataChanged(topLeft, bottomRight, roles);
+}
+
+template<typename T>
+QModelIndex DosQAbstractItemModelWrapper<T>::publicCreateIndex(int row, int column, void *data) const
+{
+    return m_dosImpl->publicCreateIndex(row, column, data);
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::hasIndex(int row, int column, const QModelIndex &parent) const
+{
+    return m_dosImpl->hasIndex(row, column, parent);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::fetchComplete(const QModelIndex &parent, int count)
+{
+    m_dosImpl->fetchComplete(parent, count);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::queueDataChanged(int row, int column, const int *roles, int rolesCount)
+{
+    m_dosImpl->queueDataChanged(row, column, roles, rolesCount);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::flushDataChanged()
+{
+    m_dosImpl->flushDataChanged();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::setDataCacheBudget(int bytes)
+{
+    m_dosImpl->setDataCacheBudget(bytes);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::setFetchRangeCallback(FetchRangeCallback callback)
+{
+    m_dosImpl->setFetchRangeCallback(callback);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::setMoveRowsCallback(MoveRowsCallback callback)
+{
+    m_dosImpl->setMoveRowsCallback(callback);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::setValueCallbacks(const DosQAbstractItemModelValueCallbacks &callbacks)
+{
+    m_dosImpl->setValueCallbacks(callbacks);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::setCommitFetchedRowsCallback(CommitFetchedRowsCallback callback)
+{
+    m_dosImpl->setCommitFetchedRowsCallback(callback);
+}
+
+template<typename T>
+QAbstractItemModel *DosQAbstractItemModelWrapper<T>::itemModel()
+{
+    return m_impl;
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::setStaticData(int staticData)
+{
+    m_dosImpl->setStaticData(staticData);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::invalidateRoleNames()
+{
+    m_dosImpl->invalidateRoleNames();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::invalidateFlags()
+{
+    m_dosImpl->invalidateFlags();
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::invalidateHeaderData(Qt::Orientation orientation, int first, int last)
+{
+    m_dosImpl->invalidateHeaderData(orientation, first, last);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::applySnapshot(std::vector<quint64> keys, std::vector<quint64> hashes)
+{
+    m_dosImpl->applySnapshot(std::move(keys), std::move(hashes));
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::enableTree(int columnCount)
+{
+    m_dosImpl->enableTree(columnCount);
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::treeInsert(const QModelIndex &parent, int row, const quintptr *payloads, int count)
+{
+    return m_dosImpl->treeInsert(parent, row, payloads, count);
+}
+
+template<typename T>
+bool DosQAbstractItemModelWrapper<T>::treeRemove(const QModelIndex &parent, int row, int count)
+{
+    return m_dosImpl->treeRemove(parent, row, count);
+}
+
+template<typename T>
+QModelIndex DosQAbstractItemModelWrapper<T>::treeIndex(quintptr payload, int column) const
+{
+    return m_dosImpl->treeIndex(payload, column);
+}
+
+template<typename T>
+void DosQAbstractItemModelWrapper<T>::treeClear()
+{
+    m_dosImpl->treeClear();
+}
+
+template class DosQAbstractItemModelWrapper<QAbstractItemModel>;
+template class DosQAbstractItemModelWrapper<QAbstractListModel>;
+template class DosQAbstractItemModelWrapper<QAbstractTableModel>;
+
+} // namespace DOS
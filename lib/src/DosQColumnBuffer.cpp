@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQColumnBuffer.h"
+
+// std
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+template<typename Stored, typename Input>
+struct ColumnConversion
+{
+    static Stored fromInput(const Input &value)
+    {
+        return value;
+    }
+
+    static QVariant toVariant(const Stored &value)
+    {
+        return QVariant::fromValue(value);
+    }
+};
+
+template<>
+struct ColumnConversion<quint8, bool>
+{
+    static quint8 fromInput(bool value)
+    {
+        return value ? 1 : 0;
+    }
+
+    static QVariant toVariant(quint8 value)
+    {
+        return QVariant(value != 0);
+    }
+};
+
+template<>
+struct ColumnConversion<QString, const char *>
+{
+    static QString fromInput(const char *value)
+    {
+        return QString::fromUtf8(value);
+    }
+
+    static QVariant toVariant(const QString &value)
+    {
+        return QVariant(value);
+    }
+};
+
+template<typename Stored, typename Input>
+class DosQTypedColumnBuffer : public DOS::DosQColumnBuffer
+{
+public:
+    using Conversion = ColumnConversion<Stored, Input>;
+
+    explicit DosQTypedColumnBuffer(int metaType)
+        : m_metaType(metaType)
+    {}
+
+    int metaType() const override
+    {
+        return m_metaType;
+    }
+
+    int size() const override
+    {
+        return static_cast<int>(m_values.size());
+    }
+
+    QVariant value(int position) const override
+    {
+        return Conversion::toVariant(m_values[position]);
+    }
+
+    void insert(int position, const void *values, int count) override
+    {
+        auto it = m_values.insert(m_values.begin() + position, count, Stored());
+        if (!values)
+            return;
+        auto input = static_cast<const Input *>(values);
+        for (int i = 0; i < count; ++i, ++it)
+            *it = Conversion::fromInput(input[i]);
+    }
+
+    void update(int position, const void *values, int count) override
+    {
+        auto input = static_cast<const Input *>(values);
+        for (int i = 0; i < count; ++i)
+            m_values[position + i] = Conversion::fromInput(input[i]);
+    }
+
+    void remove(int position, int count) override
+    {
+        m_values.erase(m_values.begin() + position, m_values.begin() + position + count);
+    }
+
+    void copy(int position, const DOS::DosQColumnBuffer &source, int sourcePosition, int count) override
+    {
+        Q_ASSERT(source.metaType() == m_metaType);
+        auto &values = static_cast<const DosQTypedColumnBuffer &>(source).m_values;
+        std::copy(values.begin() + sourcePosition, values.begin() + sourcePosition + count, m_values.begin() + position);
+    }
+
+private:
+    const int m_metaType;
+    std::vector<Stored> m_values;
+};
+
+}
+
+namespace DOS {
+
+std::unique_ptr<DosQColumnBuffer> DosQColumnBuffer::create(int metaType)
+{
+    switch (metaType) {
+    case QMetaType::Bool:
+        return std::unique_ptr<DosQColumnBuffer>(new DosQTypedColumnBuffer<quint8, bool>(metaType));
+    case QMetaType::Int:
+        return std::unique_ptr<DosQColumnBuffer>(new DosQTypedColumnBuffer<int, int>(metaType));
+    case QMetaType::LongLong:
+        return std::unique_ptr<DosQColumnBuffer>(new DosQTypedColumnBuffer<qlonglong, long long>(metaType));
+    case QMetaType::Float:
+        return std::unique_ptr<DosQColumnBuffer>(new DosQTypedColumnBuffer<float, float>(metaType));
+    case QMetaType::Double:
+        return std::unique_ptr<DosQColumnBuffer>(new DosQTypedColumnBuffer<double, double>(metaType));
+    case QMetaType::QString:
+        return std::unique_ptr<DosQColumnBuffer>(new DosQTypedColumnBuffer<QString, const char *>(metaType));
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace DOS
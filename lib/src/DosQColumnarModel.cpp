@@ -0,0 +1,375 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQColumnarModel.h"
+
+// std
+#include <algorithm>
+
+// Qt
+#include <QtCore/QTimer>
+
+namespace {
+
+/// Delay of the automatic replay of the journal, about one frame
+const int JournalReplayInterval = 16;
+
+}
+
+namespace DOS {
+
+DosQColumnarModel::DosQColumnarModel(void *modelObject,
+                                     DosIQMetaObjectPtr metaObject,
+                                     DObjectCallback dObjectCallback,
+                                     std::vector<std::unique_ptr<DosQColumnBuffer>> columns,
+                                     const std::vector<QByteArray> &roleNames)
+    : DosQAbstractListModel(modelObject, std::move(metaObject), dObjectCallback)
+    , m_columns(std::move(columns))
+{
+    for (const auto &column : m_columns)
+        m_roleTypes.push_back(column->metaType());
+    for (size_t i = 0; i < roleNames.size(); ++i)
+        m_roleNames.insert(Qt::UserRole + 1 + static_cast<int>(i), roleNames[i]);
+}
+
+int DosQColumnarModel::roleCount() const
+{
+    return static_cast<int>(m_columns.size());
+}
+
+bool DosQColumnarModel::insertRange(int row, int count, const void **columns)
+{
+    if (row < 0 || row > m_rowCount || count < 0)
+        return false;
+    if (count == 0)
+        return true;
+
+    publicBeginInsertRows(QModelIndex(), row, row + count - 1);
+    for (size_t i = 0; i < m_columns.size(); ++i)
+        m_columns[i]->insert(row, columns ? columns[i] : nullptr, count);
+    m_rowCount += count;
+    publicEndInsertRows();
+    return true;
+}
+
+bool DosQColumnarModel::updateRange(int row, int count, const void **columns)
+{
+    if (row < 0 || count < 0 || row + count > m_rowCount || !columns)
+        return false;
+    if (count == 0)
+        return true;
+
+    QVector<int> roles;
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        if (!columns[i])
+            continue;
+        m_columns[i]->update(row, columns[i], count);
+        roles.push_back(Qt::UserRole + 1 + static_cast<int>(i));
+    }
+
+    if (!roles.isEmpty())
+        publicDataChanged(createIndex(row, 0), createIndex(row + count - 1, 0), roles);
+    return true;
+}
+
+bool DosQColumnarModel::removeRange(int row, int count)
+{
+    if (row < 0 || count < 0 || row + count > m_rowCount)
+        return false;
+    if (count == 0)
+        return true;
+
+    publicBeginRemoveRows(QModelIndex(), row, row + count - 1);
+    for (auto &column : m_columns)
+        column->remove(row, count);
+    m_rowCount -= count;
+    publicEndRemoveRows();
+    return true;
+}
+
+void DosQColumnarModel::clear()
+{
+    publicBeginResetModel();
+    for (auto &column : m_columns)
+        column->remove(0, m_rowCount);
+    m_rowCount = 0;
+    publicEndResetModel();
+}
+
+int DosQColumnarModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int DosQColumnarModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QVariant DosQColumnarModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount || index.column() != 0)
+        return QVariant();
+    const DosQColumnBuffer *buffer = column(role);
+    return buffer ? buffer->value(index.row()) : QVariant();
+}
+
+bool DosQColumnarModel::setData(const QModelIndex &, const QVariant &, int)
+{
+    return false;
+}
+
+Qt::ItemFlags DosQColumnarModel::flags(const QModelIndex &index) const
+{
+    return QAbstractListModel::flags(index);
+}
+
+QVariant DosQColumnarModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    return QAbstractListModel::headerData(section, orientation, role);
+}
+
+QModelIndex DosQColumnarModel::index(int row, int column, const QModelIndex &parent) const
+{
+    return QAbstractListModel::index(row, column, parent);
+}
+
+QModelIndex DosQColumnarModel::parent(const QModelIndex &) const
+{
+    return QModelIndex();
+}
+
+QHash<int, QByteArray> DosQColumnarModel::roleNames() const
+{
+    return m_roleNames;
+}
+
+bool DosQColumnarModel::hasChildren(const QModelIndex &parent) const
+{
+    return parent.isValid() ? false : m_rowCount > 0;
+}
+
+bool DosQColumnarModel::canFetchMore(const QModelIndex &) const
+{
+    return false;
+}
+
+void DosQColumnarModel::fetchMore(const QModelIndex &)
+{
+}
+
+void DosQColumnarModel::journalInsert(int row, int count, const void **columns)
+{
+    if (count > 0)
+        record(DosQModelJournalEntry::Type::Insert, row, count, 0, copyColumns(count, columns));
+}
+
+void DosQColumnarModel::journalUpdate(int row, int count, const void **columns)
+{
+    if (count > 0 && columns)
+        record(DosQModelJournalEntry::Type::Update, row, count, 0, copyColumns(count, columns));
+}
+
+void DosQColumnarModel::journalRemove(int row, int count)
+{
+    if (count > 0)
+        record(DosQModelJournalEntry::Type::Remove, row, count, 0, Columns());
+}
+
+void DosQColumnarModel::journalMove(int row, int count, int destination)
+{
+    if (count > 0)
+        record(DosQModelJournalEntry::Type::Move, row, count, destination, Columns());
+}
+
+void DosQColumnarModel::replayJournal()
+{
+    const std::vector<std::unique_ptr<DosQModelJournalEntry>> entries = m_journal.take();
+
+    // Updates are applied right away while their dataChanged is delayed for merging it
+    int changedFirst = -1;
+    int changedLast = -1;
+    QVector<int> changedRoles;
+    auto emitDataChanged = [&] {
+        if (changedFirst >= 0)
+            publicDataChanged(createIndex(changedFirst, 0), createIndex(changedLast, 0), changedRoles);
+        changedFirst = -1;
+    };
+
+    size_t i = 0;
+    while (i < entries.size()) {
+        const DosQModelJournalEntry &entry = *entries[i];
+        if (entry.type != DosQModelJournalEntry::Type::Update) {
+            emitDataChanged();
+            if (entry.type == DosQModelJournalEntry::Type::Insert) {
+                i += replayInsert(entries, i);
+            } else if (entry.type == DosQModelJournalEntry::Type::Remove) {
+                i += replayRemove(entries, i);
+            } else {
+                replayMove(entry);
+                ++i;
+            }
+            continue;
+        }
+
+        ++i;
+        if (entry.row < 0 || entry.row + entry.count > m_rowCount)
+            continue;
+
+        QVector<int> roles;
+        for (size_t j = 0; j < m_columns.size(); ++j) {
+            if (!entry.columns[j])
+                continue;
+            m_columns[j]->copy(entry.row, *entry.columns[j], 0, entry.count);
+            roles.push_back(Qt::UserRole + 1 + static_cast<int>(j));
+        }
+
+        const int last = entry.row + entry.count - 1;
+        if (changedFirst >= 0 && roles == changedRoles && entry.row <= changedLast + 1 && last + 1 >= changedFirst) {
+            changedFirst = std::min(changedFirst, entry.row);
+            changedLast = std::max(changedLast, last);
+        } else {
+            emitDataChanged();
+            changedFirst = entry.row;
+            changedLast = last;
+            changedRoles = roles;
+        }
+    }
+    emitDataChanged();
+}
+
+size_t DosQColumnarModel::replayInsert(const std::vector<std::unique_ptr<DosQModelJournalEntry>> &entries, size_t first)
+{
+    const int row = entries[first]->row;
+    if (row < 0 || row > m_rowCount)
+        return 1;
+
+    // Each insertion must start right after the rows inserted by the previous one
+    size_t last = first;
+    int count = 0;
+    while (last < entries.size() && entries[last]->type == DosQModelJournalEntry::Type::Insert && entries[last]->row == row + count) {
+        count += entries[last]->count;
+        ++last;
+    }
+
+    publicBeginInsertRows(QModelIndex(), row, row + count - 1);
+    for (size_t i = first; i < last; ++i) {
+        const DosQModelJournalEntry &entry = *entries[i];
+        for (size_t j = 0; j < m_columns.size(); ++j) {
+            m_columns[j]->insert(entry.row, nullptr, entry.count);
+            if (entry.columns[j])
+                m_columns[j]->copy(entry.row, *entry.columns[j], 0, entry.count);
+        }
+    }
+    m_rowCount += count;
+    publicEndInsertRows();
+    return last - first;
+}
+
+size_t DosQColumnarModel::replayRemove(const std::vector<std::unique_ptr<DosQModelJournalEntry>> &entries, size_t first)
+{
+    int row = entries[first]->row;
+    int count = entries[first]->count;
+    if (row < 0 || row + count > m_rowCount)
+        return 1;
+
+    // Removals of the rows following or preceding the removed ones are merged
+    size_t last = first + 1;
+    for (; last < entries.size() && entries[last]->type == DosQModelJournalEntry::Type::Remove; ++last) {
+        const DosQModelJournalEntry &entry = *entries[last];
+        if (entry.row == row && row + count + entry.count <= m_rowCount) {
+            count += entry.count;
+        } else if (entry.row >= 0 && entry.row + entry.count == row) {
+            row = entry.row;
+            count += entry.count;
+        } else {
+            break;
+        }
+    }
+
+    publicBeginRemoveRows(QModelIndex(), row, row + count - 1);
+    for (auto &column : m_columns)
+        column->remove(row, count);
+    m_rowCount -= count;
+    publicEndRemoveRows();
+    return last - first;
+}
+
+void DosQColumnarModel::replayMove(const DosQModelJournalEntry &entry)
+{
+    const int row = entry.row;
+    const int count = entry.count;
+    const int destination = entry.destination;
+    if (row < 0 || row + count > m_rowCount || destination < 0 || destination > m_rowCount)
+        return;
+    if (!publicBeginMoveRows(QModelIndex(), row, row + count - 1, QModelIndex(), destination))
+        return;
+
+    // The destination is a row before the move thus it shifts when moving rows down
+    const int target = destination > row ? destination - count : destination;
+    for (auto &column : m_columns) {
+        auto moved = DosQColumnBuffer::create(column->metaType());
+        moved->insert(0, nullptr, count);
+        moved->copy(0, *column, row, count);
+        column->remove(row, count);
+        column->insert(target, nullptr, count);
+        column->copy(target, *moved, 0, count);
+    }
+    publicEndMoveRows();
+}
+
+DosQColumnarModel::Columns DosQColumnarModel::copyColumns(int count, const void **columns) const
+{
+    Columns result(m_roleTypes.size());
+    for (size_t i = 0; i < m_roleTypes.size(); ++i) {
+        if (!columns || !columns[i])
+            continue;
+        result[i] = DosQColumnBuffer::create(m_roleTypes[i]);
+        result[i]->insert(0, columns[i], count);
+    }
+    return result;
+}
+
+void DosQColumnarModel::record(DosQModelJournalEntry::Type type, int row, int count, int destination, Columns columns)
+{
+    std::unique_ptr<DosQModelJournalEntry> entry(new DosQModelJournalEntry());
+    entry->type = type;
+    entry->row = row;
+    entry->count = count;
+    entry->destination = destination;
+    entry->columns = std::move(columns);
+    if (!m_journal.push(std::move(entry)))
+        return;
+
+    // A single replay is scheduled for all the entries recorded until then
+    QMetaObject::invokeMethod(this, [this] {
+        QTimer::singleShot(JournalReplayInterval, this, [this] { replayJournal(); });
+    }, Qt::QueuedConnection);
+}
+
+const DosQColumnBuffer *DosQColumnarModel::column(int role) const
+{
+    // The display role is an alias of the first role
+    const int position = role == Qt::DisplayRole ? 0 : role - Qt::UserRole - 1;
+    if (position < 0 || position >= roleCount())
+        return nullptr;
+    return m_columns[position].get();
+}
+
+} // namespace DOS
@@ -0,0 +1,157 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQDataChangedBuffer.h"
+
+// std
+#include <algorithm>
+
+// Qt
+#include <QtCore/QPair>
+
+namespace {
+
+QVector<int> uniteRoles(const QVector<int> &lhs, const QVector<int> &rhs)
+{
+    if (lhs.isEmpty() || rhs.isEmpty())
+        return QVector<int>();
+    QVector<int> result = lhs;
+    result += rhs;
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+}
+
+namespace DOS {
+
+void DosQDataChangedBuffer::add(int row, int column, const int *roles, int rolesCount)
+{
+    Cell cell;
+    cell.column = column;
+    cell.row = row;
+    cell.roleSet = roleSetId(roles, roles ? rolesCount : 0);
+    m_cells.push_back(cell);
+}
+
+bool DosQDataChangedBuffer::isEmpty() const
+{
+    return m_cells.empty();
+}
+
+std::vector<DosQDataChangedBuffer::Range> DosQDataChangedBuffer::take()
+{
+    std::vector<Range> result;
+    if (m_cells.empty())
+        return result;
+
+    std::sort(m_cells.begin(), m_cells.end(), [](const Cell &lhs, const Cell &rhs) {
+        return lhs.column < rhs.column || (lhs.column == rhs.column && lhs.row < rhs.row);
+    });
+
+    // Runs of consecutive rows inside every column
+    std::vector<Range> runs;
+    std::vector<int> roleSets;
+    for (size_t i = 0; i < m_cells.size();) {
+        const Cell &first = m_cells[i];
+        int lastRow = first.row;
+        roleSets.assign(1, first.roleSet);
+        size_t j = i + 1;
+        for (; j < m_cells.size() && m_cells[j].column == first.column && m_cells[j].row <= lastRow + 1; ++j) {
+            lastRow = std::max(lastRow, m_cells[j].row);
+            roleSets.push_back(m_cells[j].roleSet);
+        }
+
+        Range run;
+        run.firstRow = first.row;
+        run.lastRow = lastRow;
+        run.firstColumn = first.column;
+        run.lastColumn = first.column;
+        run.roles = unite(roleSets);
+        runs.push_back(std::move(run));
+        i = j;
+    }
+
+    // Runs spanning the same rows of adjacent columns become a single rectangle
+    QHash<QPair<int, int>, size_t> open;
+    for (Range &run : runs) {
+        const QPair<int, int> rows(run.firstRow, run.lastRow);
+        auto it = open.constFind(rows);
+        if (it != open.constEnd() && result[it.value()].lastColumn == run.firstColumn - 1) {
+            Range &range = result[it.value()];
+            range.lastColumn = run.lastColumn;
+            range.roles = uniteRoles(range.roles, run.roles);
+        } else {
+            open.insert(rows, result.size());
+            result.push_back(std::move(run));
+        }
+    }
+
+    clear();
+    return result;
+}
+
+void DosQDataChangedBuffer::clear()
+{
+    m_cells.clear();
+    m_roleSets.clear();
+    m_roleSetIds.clear();
+    m_lastRoles.clear();
+    m_lastRoleSet = -1;
+}
+
+int DosQDataChangedBuffer::roleSetId(const int *roles, int rolesCount)
+{
+    // Cells changed together usually share the same roles
+    if (m_lastRoleSet >= 0 && m_lastRoles.size() == rolesCount
+            && std::equal(roles, roles + rolesCount, m_lastRoles.constBegin()))
+        return m_lastRoleSet;
+
+    m_lastRoles.clear();
+    m_lastRoles.reserve(rolesCount);
+    for (int i = 0; i < rolesCount; ++i)
+        m_lastRoles.push_back(roles[i]);
+
+    QVector<int> key = m_lastRoles;
+    std::sort(key.begin(), key.end());
+    key.erase(std::unique(key.begin(), key.end()), key.end());
+
+    auto it = m_roleSetIds.constFind(key);
+    if (it != m_roleSetIds.constEnd()) {
+        m_lastRoleSet = it.value();
+    } else {
+        m_lastRoleSet = static_cast<int>(m_roleSets.size());
+        m_roleSets.push_back(key);
+        m_roleSetIds.insert(key, m_lastRoleSet);
+    }
+    return m_lastRoleSet;
+}
+
+QVector<int> DosQDataChangedBuffer::unite(std::vector<int> roleSets) const
+{
+    std::sort(roleSets.begin(), roleSets.end());
+    roleSets.erase(std::unique(roleSets.begin(), roleSets.end()), roleSets.end());
+    QVector<int> result = m_roleSets[roleSets.front()];
+    for (size_t i = 1; i < roleSets.size() && !result.isEmpty(); ++i)
+        result = uniteRoles(result, m_roleSets[roleSets[i]]);
+    return result;
+}
+
+} // namespace DOS
@@ -21,8 +21,18 @@
 #include "DOtherSide/DosQObjectWrapper.h"
 #include "DOtherSide/DosQAbstractItemModelWrapper.h"
 
+// std
+#include <cstddef>
+#include <deque>
+// Qt
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtQml/qqml.h>
+
 namespace DOS {
 
+namespace {
+
 template<class T>
 bool isItemModel(const QMetaObject *metaObject)
 {
@@ -35,32 +45,438 @@ bool isItemModel(const QMetaObject *metaObject)
     return false;
 }
 
+/// Return the storage of the registrations. A deque never moves its elements thus
+/// the wrappers can keep a reference to their registration
+std::deque<DosQmlTypeRegistration> &registrations()
+{
+    static std::deque<DosQmlTypeRegistration> result;
+    return result;
+}
+
+template<class T>
+void createInto(void *memory, const DosQmlTypeRegistration &registration)
+{
+    new (memory) T(registration);
+}
+
+/// Run the preparation of a singleton unless already done, waiting for it if it runs on a worker thread
+void prepareSingleton(const DosQmlTypeRegistration &registration)
+{
+    DosQmlSingletonState &state = *registration.singleton;
+    if (state.prepared.valid())
+        state.prepared.get();
+    else if (state.prepare)
+        state.prepare(registration.id);
+    state.prepare = nullptr;
+}
+
+/// Return the instance created ahead of time, if any, or create a new one
+template<class T>
+QObject *createSingleton(const DosQmlTypeRegistration &registration)
+{
+    DosQmlSingletonState &state = *registration.singleton;
+    if (QObject *result = state.instance) {
+        state.instance = nullptr;
+        return result;
+    }
+    prepareSingleton(registration);
+    return new T(registration);
+}
+
+bool singletonsReleaseScheduled = false;
+
+/// Wait for the preparations still running and delete the instances no engine took.
+/// Both call back into the bindings thus they must end before the application goes away
+void releaseSingletons()
+{
+    singletonsReleaseScheduled = false;
+    for (DosQmlTypeRegistration &registration : registrations()) {
+        DosQmlSingletonState *state = registration.singleton.get();
+        if (!state)
+            continue;
+        if (state->prepared.valid())
+            state->prepared.wait();
+        delete state->instance;
+        state->instance = nullptr;
+    }
+}
+
+/// Release the singletons when the application quits or, if it never runs, when it's deleted
+void scheduleSingletonsRelease()
+{
+    if (singletonsReleaseScheduled)
+        return;
+    singletonsReleaseScheduled = true;
+    qAddPostRoutine(&releaseSingletons);
+    if (QCoreApplication *application = QCoreApplication::instance())
+        QObject::connect(application, &QCoreApplication::aboutToQuit, &releaseSingletons);
+}
+
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+
+template<class T>
+void create(void *memory, void *registration)
+{
+    createInto<T>(memory, *static_cast<const DosQmlTypeRegistration *>(registration));
+}
+
+// The metatype interface is private to Qt and its layout may change with any minor release.
+// Only the layouts checked below are filled, other versions share the metatype of the wrapper class
+#if (QT_VERSION < QT_VERSION_CHECK(6, 9, 0))
+#define DOS_QMETATYPEINTERFACE_LAYOUT
+static_assert(sizeof(QtPrivate::QMetaTypeInterface) == 4 * sizeof(int) + 12 * sizeof(void *),
+              "Unexpected size of QtPrivate::QMetaTypeInterface");
+static_assert(offsetof(QtPrivate::QMetaTypeInterface, metaObjectFn) == 4 * sizeof(int),
+              "Unexpected layout of QtPrivate::QMetaTypeInterface");
+static_assert(offsetof(QtPrivate::QMetaTypeInterface, name) == 4 * sizeof(int) + sizeof(void *),
+              "Unexpected layout of QtPrivate::QMetaTypeInterface");
+static_assert(offsetof(QtPrivate::QMetaTypeInterface, legacyRegisterOp) == 4 * sizeof(int) + 11 * sizeof(void *),
+              "Unexpected layout of QtPrivate::QMetaTypeInterface");
+#endif
+
+#ifdef DOS_QMETATYPEINTERFACE_LAYOUT
+
+/// A metatype interface named after a registered class. It lets QML tell apart the types
+/// sharing the same wrapper class
+struct DosQmlMetaTypeInterface : QtPrivate::QMetaTypeInterface {
+    DosQmlMetaTypeInterface(const QtPrivate::QMetaTypeInterface &other, QByteArray typeName, const QMetaObject *typeMetaObject)
+        : QtPrivate::QMetaTypeInterface {
+              other.revision, other.alignment, other.size, other.flags, {0},
+              typeMetaObject ? &metaObjectOf : other.metaObjectFn, nullptr,
+              other.defaultCtr, other.copyCtr, other.moveCtr, other.dtor, other.equals, other.lessThan,
+              other.debugStream, other.dataStreamOut, other.dataStreamIn, other.legacyRegisterOp}
+        , storedName(std::move(typeName))
+        , metaObject(typeMetaObject)
+    {
+        name = storedName.constData();
+    }
+
+    static const QMetaObject *metaObjectOf(const QtPrivate::QMetaTypeInterface *iface)
+    {
+        return static_cast<const DosQmlMetaTypeInterface *>(iface)->metaObject;
+    }
+
+    const QByteArray storedName;
+    const QMetaObject *const metaObject;
+};
+
+/// Return the storage of the metatype interfaces. Like the registrations they must never move
+std::deque<DosQmlMetaTypeInterface> &metaTypeInterfaces()
+{
+    static std::deque<DosQmlMetaTypeInterface> result;
+    return result;
+}
+
+/// Create a metatype for the pointer to the given class
+template<class T>
+QMetaType createPointerMetaType(const QMetaObject *metaObject)
+{
+    metaTypeInterfaces().emplace_back(*QMetaType::fromType<QObject *>().iface(),
+                                      QByteArray(metaObject->className()) + '*', metaObject);
+    return QMetaType(&metaTypeInterfaces().back());
+}
+
+/// Create a metatype for the list property of the given class
+template<class T>
+QMetaType createListMetaType(const QMetaObject *metaObject)
+{
+    metaTypeInterfaces().emplace_back(*QMetaType::fromType<QQmlListProperty<QObject>>().iface(),
+                                      "QQmlListProperty<" + QByteArray(metaObject->className()) + '>', nullptr);
+    return QMetaType(&metaTypeInterfaces().back());
+}
+
+#else
+
+/// Return the metatype for the pointer to the wrapper class
+template<class T>
+QMetaType createPointerMetaType(const QMetaObject *)
+{
+    return QMetaType::fromType<T *>();
+}
+
+/// Return the metatype for the list property of the wrapper class
+template<class T>
+QMetaType createListMetaType(const QMetaObject *)
+{
+    return QMetaType::fromType<QQmlListProperty<T>>();
+}
+
+#endif
+
+template<class T>
+int registerType(const DosQmlTypeRegistration &registration)
+{
+    const QmlRegisterType &data = registration.data;
+    const QMetaObject *metaObject = data.staticMetaObject->metaObject();
+    QQmlPrivate::RegisterType type = QQmlPrivate::RegisterType();
+    type.structVersion = 0;
+    type.typeId = createPointerMetaType<T>(metaObject);
+    type.listId = createListMetaType<T>(metaObject);
+    type.objectSize = sizeof(T);
+    type.create = &create<T>;
+    type.userdata = const_cast<DosQmlTypeRegistration *>(&registration);
+    type.uri = data.uri.c_str();
+    type.version = QTypeRevision::fromVersion(data.major, data.minor);
+    type.elementName = data.qml.c_str();
+    type.metaObject = metaObject;
+    type.parserStatusCast = -1;
+    type.valueSourceCast = -1;
+    type.valueInterceptorCast = -1;
+    type.revision = QTypeRevision::zero();
+    return QQmlPrivate::qmlregister(QQmlPrivate::TypeRegistration, &type);
+}
+
+template<class T>
+int registerSingletonType(const DosQmlTypeRegistration &registration)
+{
+    registration.singleton->create = &createSingleton<T>;
+    const QmlRegisterType &data = registration.data;
+    const QMetaObject *metaObject = data.staticMetaObject->metaObject();
+    QQmlPrivate::RegisterSingletonType type = QQmlPrivate::RegisterSingletonType();
+    type.structVersion = 0;
+    type.uri = data.uri.c_str();
+    type.version = QTypeRevision::fromVersion(data.major, data.minor);
+    type.typeName = data.qml.c_str();
+    type.qObjectApi = [&registration](QQmlEngine *, QJSEngine *) -> QObject * {
+        return createSingleton<T>(registration);
+    };
+    type.instanceMetaObject = metaObject;
+    type.typeId = createPointerMetaType<T>(metaObject);
+    type.revision = QTypeRevision::zero();
+    return QQmlPrivate::qmlregister(QQmlPrivate::SingletonRegistration, &type);
+}
+
+#else
+
+/// Qt5 creates the instances through a function without user data. Each type takes one of
+/// a fixed pool of functions that forwards to the creation function of its wrapper class.
+/// Functions can't be created at runtime thus the pool bounds the number of registrations
+enum { CreatorPoolSize = 256 };
+
+using CreateFunction = void (*)(void *);
+using CreateSingletonFunction = QObject *(*)(QQmlEngine *, QJSEngine *);
+
+struct PooledCreator {
+    void (*createInto)(void *, const DosQmlTypeRegistration &);
+    QObject *(*createSingleton)(const DosQmlTypeRegistration &);
+    const DosQmlTypeRegistration *registration;
+};
+
+PooledCreator pooledCreators[CreatorPoolSize] = {};
+int pooledCreatorsCount = 0;
+
+template<int N>
+void createPooled(void *memory)
+{
+    pooledCreators[N].createInto(memory, *pooledCreators[N].registration);
+}
+
+template<int N>
+QObject *createSingletonPooled(QQmlEngine *, QJSEngine *)
+{
+    return pooledCreators[N].createSingleton(*pooledCreators[N].registration);
+}
+
+struct PooledFunctions {
+    CreateFunction create[CreatorPoolSize];
+    CreateSingletonFunction createSingleton[CreatorPoolSize];
+};
+
+/// Fill the functions [First, First + Count) of the pool. The range is split in halves
+/// so that the instantiation depth is logarithmic in the pool size
+template<int First, int Count>
+struct CreatorPool {
+    static void fill(PooledFunctions &functions)
+    {
+        CreatorPool<First, Count / 2>::fill(functions);
+        CreatorPool<First + Count / 2, Count - Count / 2>::fill(functions);
+    }
+};
+
+template<int First>
+struct CreatorPool<First, 1> {
+    static void fill(PooledFunctions &functions)
+    {
+        functions.create[First] = &createPooled<First>;
+        functions.createSingleton[First] = &createSingletonPooled<First>;
+    }
+};
+
+const PooledFunctions &pooledFunctions()
+{
+    // The initialization of a function local static is thread safe
+    static const PooledFunctions result = [] {
+        PooledFunctions functions;
+        CreatorPool<0, CreatorPoolSize>::fill(functions);
+        return functions;
+    }();
+    return result;
+}
+
+/// Return the index of the pool functions taken by the registration or -1 if the pool is exhausted
+int acquirePooledCreator(const PooledCreator &creator)
+{
+    if (pooledCreatorsCount == CreatorPoolSize) {
+        qWarning() << "C++: qmlRegisterType: cannot register more than" << CreatorPoolSize << "QML types with Qt5";
+        return -1;
+    }
+    pooledCreators[pooledCreatorsCount] = creator;
+    return pooledCreatorsCount++;
+}
+
+template<class T>
+CreateFunction acquireCreator(const DosQmlTypeRegistration &registration)
+{
+    const int index = acquirePooledCreator(PooledCreator {&createInto<T>, nullptr, &registration});
+    return index == -1 ? nullptr : pooledFunctions().create[index];
+}
+
+template<class T>
+CreateSingletonFunction acquireSingletonCreator(const DosQmlTypeRegistration &registration)
+{
+    const int index = acquirePooledCreator(PooledCreator {nullptr, &createSingleton<T>, &registration});
+    return index == -1 ? nullptr : pooledFunctions().createSingleton[index];
+}
+
+/// Register a metatype for the pointer to the given class. It lets QML tell apart
+/// the types sharing the same wrapper class
+int registerPointerMetaType(const QMetaObject *metaObject)
+{
+    using Helper = QtMetaTypePrivate::QMetaTypeFunctionHelper<QObject *>;
+    return QMetaType::registerNormalizedType(QByteArray(metaObject->className()) + '*',
+                                             Helper::Destruct, Helper::Construct, int(sizeof(QObject *)),
+                                             QMetaType::TypeFlags(QtPrivate::QMetaTypeTypeFlags<QObject *>::Flags),
+                                             metaObject);
+}
+
+/// Register a metatype for the list property of the given class
+int registerListMetaType(const QMetaObject *metaObject)
+{
+    using List = QQmlListProperty<QObject>;
+    using Helper = QtMetaTypePrivate::QMetaTypeFunctionHelper<List>;
+    return QMetaType::registerNormalizedType("QQmlListProperty<" + QByteArray(metaObject->className()) + '>',
+                                             Helper::Destruct, Helper::Construct, int(sizeof(List)),
+                                             QMetaType::TypeFlags(QtPrivate::QMetaTypeTypeFlags<List>::Flags),
+                                             nullptr);
+}
+
+template<class T>
+int registerType(const DosQmlTypeRegistration &registration)
+{
+    CreateFunction create = acquireCreator<T>(registration);
+    if (!create)
+        return -1;
+
+    const QmlRegisterType &data = registration.data;
+    const QMetaObject *metaObject = data.staticMetaObject->metaObject();
+    QQmlPrivate::RegisterType type = QQmlPrivate::RegisterType();
+    type.version = 0;
+    type.typeId = registerPointerMetaType(metaObject);
+    type.listId = registerListMetaType(metaObject);
+    type.objectSize = sizeof(T);
+    type.create = create;
+    type.uri = data.uri.c_str();
+    type.versionMajor = data.major;
+    type.versionMinor = data.minor;
+    type.elementName = data.qml.c_str();
+    type.metaObject = metaObject;
+    type.parserStatusCast = -1;
+    type.valueSourceCast = -1;
+    type.valueInterceptorCast = -1;
+    type.revision = 0;
+    return QQmlPrivate::qmlregister(QQmlPrivate::TypeRegistration, &type);
+}
+
+template<class T>
+int registerSingletonType(const DosQmlTypeRegistration &registration)
+{
+    CreateSingletonFunction create = acquireSingletonCreator<T>(registration);
+    if (!create)
+        return -1;
+
+    registration.singleton->create = &createSingleton<T>;
+    const QmlRegisterType &data = registration.data;
+    const QMetaObject *metaObject = data.staticMetaObject->metaObject();
+    QQmlPrivate::RegisterSingletonType type = QQmlPrivate::RegisterSingletonType();
+    type.version = 2;
+    type.uri = data.uri.c_str();
+    type.versionMajor = data.major;
+    type.versionMinor = data.minor;
+    type.typeName = data.qml.c_str();
+    type.instanceMetaObject = metaObject;
+    type.typeId = registerPointerMetaType(metaObject);
+    type.revision = 0;
+    type.qobjectApi = create;
+    return QQmlPrivate::qmlregister(QQmlPrivate::SingletonRegistration, &type);
+}
+
+#endif
+
+using RegisterFunction = int (*)(const DosQmlTypeRegistration &);
+
+/// Store the registration and register it with the function matching its wrapper class
+DosQmlTypeRegistration &registerWith(QmlRegisterType args, std::unique_ptr<DosQmlSingletonState> singleton,
+                                     RegisterFunction itemModel, RegisterFunction listModel,
+                                     RegisterFunction tableModel, RegisterFunction object)
+{
+    registrations().emplace_back();
+    DosQmlTypeRegistration &registration = registrations().back();
+    registration.data = std::move(args);
+    registration.singleton = std::move(singleton);
+
+    const QMetaObject *metaObject = registration.data.staticMetaObject->metaObject();
+    RegisterFunction function = object;
+    if (isItemModel<QAbstractListModel>(metaObject))
+        function = listModel;
+    else if (isItemModel<QAbstractTableModel>(metaObject))
+        function = tableModel;
+    else if (isItemModel<QAbstractItemModel>(metaObject))
+        function = itemModel;
+
+    registration.id = function(registration);
+    return registration;
+}
+
+}
+
 int dosQmlRegisterType(QmlRegisterType args)
 {
-    static int i = 0;
-    static int j = 0;
-    if (isItemModel<QAbstractListModel>(args.staticMetaObject->metaObject()))
-        return DQAIMW::DosQmlRegisterHelper<QAbstractListModel, 35>::Register(j++, std::move(args));
-    else if (isItemModel<QAbstractTableModel>(args.staticMetaObject->metaObject()))
-        return DQAIMW::DosQmlRegisterHelper<QAbstractTableModel, 35>::Register(j++, std::move(args));
-    else if (isItemModel<QAbstractItemModel>(args.staticMetaObject->metaObject()))
-        return DQAIMW::DosQmlRegisterHelper<QAbstractItemModel, 35>::Register(j++, std::move(args));
-    else
-        return DQOW::DosQmlRegisterHelper<35>::Register(i++, std::move(args));
-}
-
-int dosQmlRegisterSingletonType(QmlRegisterType args)
-{
-    static int i = 0;
-    static int j = 0;
-    if (isItemModel<QAbstractListModel>(args.staticMetaObject->metaObject()))
-        return DQAIMW::DosQmlRegisterSingletonHelper<QAbstractListModel, 35>::Register(j++, std::move(args));
-    else if (isItemModel<QAbstractTableModel>(args.staticMetaObject->metaObject()))
-        return DQAIMW::DosQmlRegisterSingletonHelper<QAbstractTableModel, 35>::Register(j++, std::move(args));
-    else if (isItemModel<QAbstractItemModel>(args.staticMetaObject->metaObject()))
-        return DQAIMW::DosQmlRegisterSingletonHelper<QAbstractItemModel, 35>::Register(j++, std::move(args));
-    else
-        return DQOW::DosQmlRegisterSingletonHelper<35>::Register(i++, std::move(args));
+    return registerWith(std::move(args), nullptr,
+                        &registerType<DosQAbstractItemModelWrapper<QAbstractItemModel>>,
+                        &registerType<DosQAbstractItemModelWrapper<QAbstractListModel>>,
+                        &registerType<DosQAbstractItemModelWrapper<QAbstractTableModel>>,
+                        &registerType<DosQObjectWrapper>).id;
+}
+
+int dosQmlRegisterSingletonType(QmlRegisterType args, DosQmlSingletonMode mode, PrepareDObject prepare)
+{
+    std::unique_ptr<DosQmlSingletonState> singleton(new DosQmlSingletonState());
+    singleton->prepare = prepare;
+    const DosQmlTypeRegistration &registration = registerWith(std::move(args), std::move(singleton),
+                                                              &registerSingletonType<DosQAbstractItemModelWrapper<QAbstractItemModel>>,
+                                                              &registerSingletonType<DosQAbstractItemModelWrapper<QAbstractListModel>>,
+                                                              &registerSingletonType<DosQAbstractItemModelWrapper<QAbstractTableModel>>,
+                                                              &registerSingletonType<DosQObjectWrapper>);
+    if (registration.id == -1)
+        return registration.id;
+
+    DosQmlSingletonState &state = *registration.singleton;
+    if (mode != DosQmlSingletonModeLazy)
+        scheduleSingletonsRelease();
+    switch (mode) {
+    case DosQmlSingletonModeEager:
+        state.instance = state.create(registration);
+        break;
+    case DosQmlSingletonModePreloaded:
+        if (state.prepare) {
+            state.prepared = std::async(std::launch::async, state.prepare, registration.id);
+            state.prepare = nullptr;
+        }
+        break;
+    case DosQmlSingletonModeLazy:
+        break;
+    }
+    return registration.id;
 }
 
 }
@@ -0,0 +1,308 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQMappedFileModel.h"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// Qt
+#include <QtCore/QtEndian>
+
+namespace {
+
+/// Return the size of a field of the given type or 0 for variable size fields
+int fieldSize(int type)
+{
+    switch (type) {
+    case DosMappedFieldInt8:
+    case DosMappedFieldUInt8:
+        return 1;
+    case DosMappedFieldInt16:
+    case DosMappedFieldUInt16:
+        return 2;
+    case DosMappedFieldInt32:
+    case DosMappedFieldUInt32:
+    case DosMappedFieldFloat:
+        return 4;
+    case DosMappedFieldInt64:
+    case DosMappedFieldUInt64:
+    case DosMappedFieldDouble:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+template<typename T>
+QVariant decodeNumber(const uchar *data)
+{
+    return QVariant::fromValue(qFromLittleEndian<T>(data));
+}
+
+template<typename Floating, typename Bits>
+QVariant decodeFloating(const uchar *data)
+{
+    const Bits bits = qFromLittleEndian<Bits>(data);
+    Floating result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return QVariant::fromValue(result);
+}
+
+}
+
+namespace DOS {
+
+DosQMappedFileModel::DosQMappedFileModel(void *modelObject,
+                                         DosIQMetaObjectPtr metaObject,
+                                         DObjectCallback dObjectCallback,
+                                         const QString &dataPath,
+                                         const QString &indexPath,
+                                         int headerSize,
+                                         int recordSize,
+                                         const std::vector<DosMappedFieldDefinition> &fields)
+    : DosQAbstractListModel(modelObject, std::move(metaObject), dObjectCallback)
+    , m_headerSize(std::max(headerSize, 0))
+    , m_recordSize(recordSize)
+    , m_indexed(!indexPath.isEmpty())
+{
+    for (size_t i = 0; i < fields.size(); ++i) {
+        m_fields.push_back(Field {fields[i].type, fields[i].offset, fields[i].size});
+        m_roleNames.insert(Qt::UserRole + 1 + static_cast<int>(i), QByteArray(fields[i].name));
+    }
+
+    m_data.file.setFileName(dataPath);
+    m_index.file.setFileName(indexPath);
+    m_open = m_data.file.open(QIODevice::ReadOnly) && (!m_indexed || m_index.file.open(QIODevice::ReadOnly));
+    m_open = m_open && (m_indexed || m_recordSize > 0);
+    m_open = m_open && map(m_data) && (!m_indexed || map(m_index));
+    if (m_open)
+        m_rowCount = recordCount();
+}
+
+DosQMappedFileModel::~DosQMappedFileModel()
+{
+    unmap(m_data);
+    unmap(m_index);
+}
+
+bool DosQMappedFileModel::isOpen() const
+{
+    return m_open;
+}
+
+bool DosQMappedFileModel::refresh()
+{
+    if (!m_open)
+        return false;
+
+    const bool truncated = m_data.file.size() < m_data.size || (m_indexed && m_index.file.size() < m_index.size);
+    if (truncated) {
+        publicBeginResetModel();
+        const bool mapped = map(m_data) && (!m_indexed || map(m_index));
+        m_rowCount = mapped ? recordCount() : 0;
+        publicEndResetModel();
+        return mapped;
+    }
+
+    // Mapped memory is only read by data() thus remapping never invalidates existing rows
+    if (!map(m_data) || (m_indexed && !map(m_index)))
+        return false;
+
+    const int count = recordCount();
+    if (count > m_rowCount) {
+        publicBeginInsertRows(QModelIndex(), m_rowCount, count - 1);
+        m_rowCount = count;
+        publicEndInsertRows();
+    }
+    return true;
+}
+
+int DosQMappedFileModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int DosQMappedFileModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QVariant DosQMappedFileModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount || index.column() != 0)
+        return QVariant();
+    // The display role is an alias of the first role
+    const int position = role == Qt::DisplayRole ? 0 : role - Qt::UserRole - 1;
+    if (position < 0 || position >= static_cast<int>(m_fields.size()))
+        return QVariant();
+    return decode(m_fields[position], index.row());
+}
+
+bool DosQMappedFileModel::setData(const QModelIndex &, const QVariant &, int)
+{
+    return false;
+}
+
+Qt::ItemFlags DosQMappedFileModel::flags(const QModelIndex &index) const
+{
+    return QAbstractListModel::flags(index);
+}
+
+QVariant DosQMappedFileModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    return QAbstractListModel::headerData(section, orientation, role);
+}
+
+QModelIndex DosQMappedFileModel::index(int row, int column, const QModelIndex &parent) const
+{
+    return QAbstractListModel::index(row, column, parent);
+}
+
+QModelIndex DosQMappedFileModel::parent(const QModelIndex &) const
+{
+    return QModelIndex();
+}
+
+QHash<int, QByteArray> DosQMappedFileModel::roleNames() const
+{
+    return m_roleNames;
+}
+
+bool DosQMappedFileModel::hasChildren(const QModelIndex &parent) const
+{
+    return parent.isValid() ? false : m_rowCount > 0;
+}
+
+bool DosQMappedFileModel::canFetchMore(const QModelIndex &) const
+{
+    return false;
+}
+
+void DosQMappedFileModel::fetchMore(const QModelIndex &)
+{
+}
+
+bool DosQMappedFileModel::map(Mapping &mapping)
+{
+    const qint64 size = mapping.file.size();
+    if (size == mapping.size)
+        return true;
+    if (size == 0) {
+        unmap(mapping);
+        return true;
+    }
+
+    // The previous mapping is kept if the new one fails
+    uchar *data = mapping.file.map(0, size);
+    if (!data)
+        return false;
+    unmap(mapping);
+    mapping.data = data;
+    mapping.size = size;
+    return true;
+}
+
+void DosQMappedFileModel::unmap(Mapping &mapping)
+{
+    if (mapping.data)
+        mapping.file.unmap(mapping.data);
+    mapping.data = nullptr;
+    mapping.size = 0;
+}
+
+int DosQMappedFileModel::recordCount() const
+{
+    qint64 result = 0;
+    if (!m_indexed) {
+        result = std::max<qint64>(m_data.size - m_headerSize, 0) / m_recordSize;
+    } else {
+        // Records whose offset was written before their payload aren't complete yet
+        result = std::min<qint64>(m_index.size / static_cast<qint64>(sizeof(quint64)), std::numeric_limits<int>::max());
+        while (result > 0 && !isValidOffset(recordOffset(static_cast<int>(result - 1))))
+            --result;
+    }
+    return static_cast<int>(std::min<qint64>(result, std::numeric_limits<int>::max()));
+}
+
+qint64 DosQMappedFileModel::recordOffset(int row) const
+{
+    if (!m_indexed)
+        return m_headerSize + static_cast<qint64>(row) * m_recordSize;
+    // Offsets come from the file thus the ones not fitting a qint64 are reported as invalid
+    const quint64 offset = qFromLittleEndian<quint64>(m_index.data + static_cast<qint64>(row) * sizeof(quint64));
+    return offset > static_cast<quint64>(std::numeric_limits<qint64>::max()) ? -1 : static_cast<qint64>(offset);
+}
+
+bool DosQMappedFileModel::isValidOffset(qint64 offset) const
+{
+    return offset >= 0 && offset <= m_data.size;
+}
+
+QVariant DosQMappedFileModel::decode(const Field &field, int row) const
+{
+    const qint64 begin = recordOffset(row);
+    if (!isValidOffset(begin))
+        return QVariant();
+    qint64 end = begin + m_recordSize;
+    if (m_indexed)
+        end = row + 1 < m_rowCount ? recordOffset(row + 1) : m_data.size;
+    end = isValidOffset(end) ? std::max(end, begin) : m_data.size;
+
+    const qint64 fieldBegin = begin + field.offset;
+    const qint64 available = end - fieldBegin;
+    const int size = fieldSize(field.type);
+    if (field.offset < 0 || available < size)
+        return QVariant();
+
+    const uchar *data = m_data.data + fieldBegin;
+    switch (field.type) {
+    case DosMappedFieldInt8:
+        return QVariant(static_cast<int>(static_cast<qint8>(*data)));
+    case DosMappedFieldUInt8:
+        return QVariant(static_cast<uint>(*data));
+    case DosMappedFieldInt16:
+        return QVariant(static_cast<int>(qFromLittleEndian<qint16>(data)));
+    case DosMappedFieldUInt16:
+        return QVariant(static_cast<uint>(qFromLittleEndian<quint16>(data)));
+    case DosMappedFieldInt32:
+        return decodeNumber<qint32>(data);
+    case DosMappedFieldUInt32:
+        return decodeNumber<quint32>(data);
+    case DosMappedFieldInt64:
+        return decodeNumber<qint64>(data);
+    case DosMappedFieldUInt64:
+        return decodeNumber<quint64>(data);
+    case DosMappedFieldFloat:
+        return decodeFloating<float, quint32>(data);
+    case DosMappedFieldDouble:
+        return decodeFloating<double, quint64>(data);
+    case DosMappedFieldUtf8: {
+        const qint64 length = field.size > 0 ? std::min<qint64>(field.size, available) : available;
+        const char *text = reinterpret_cast<const char *>(data);
+        return QVariant(QString::fromUtf8(text, static_cast<int>(qstrnlen(text, static_cast<uint>(length)))));
+    }
+    default:
+        return QVariant();
+    }
+}
+
+} // namespace DOS
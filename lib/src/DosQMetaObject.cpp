@@ -87,6 +87,18 @@ QMetaObject *createDynamicMetaObject()
     return builder.toMetaObject();
 }
 
+/// Header of the serialized tables. The version of Qt is part of it since the type names
+/// and the metaobject layout depend on it
+const quint32 TableMagic = 0x444f534d;
+const quint32 TableVersion = 1;
+const QDataStream::Version TableStreamVersion = QDataStream::Qt_5_0;
+
+/// Superclasses of a serialized table are either a base class or a previous entry of the table
+qint32 encodeBase(DOS::DosQMetaObjectBase base)
+{
+    return -1 - static_cast<qint32>(base);
+}
+
 }
 
 namespace DOS {
@@ -150,6 +162,96 @@ DosQMetaObject::DosQMetaObject(DosIQMetaObjectPtr superClassMetaObject,
     m_metaObject.reset(createMetaObject(className, signalDefinitions, slotDefinitions, propertyDefinitions));
 }
 
+DosQMetaObject::DosQMetaObject(DosIQMetaObjectPtr superClassMetaObject, QDataStream &stream)
+    : BaseDosQMetaObject(nullptr)
+    , m_superClassDosMetaObject(std::move(superClassMetaObject))
+{
+    // The signatures and the type names are stored ready for the builder
+    QMetaObjectBuilder builder;
+    QByteArray className;
+    stream >> className;
+    builder.setClassName(className);
+    builder.setSuperClass(m_superClassDosMetaObject->metaObject());
+
+    qint32 signalCount = 0;
+    stream >> signalCount;
+    for (qint32 i = 0; i < signalCount && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray signature;
+        QList<QByteArray> parameterNames;
+        stream >> signature >> parameterNames;
+        QMetaMethodBuilder signalBuilder = builder.addSignal(signature);
+        signalBuilder.setReturnType(DOS::metaTypeName(QMetaType::Void));
+        signalBuilder.setAccess(QMetaMethod::Public);
+        signalBuilder.setParameterNames(parameterNames);
+        m_signalIndexByName[QString::fromUtf8(signature.left(signature.indexOf('(')))] = signalBuilder.index();
+    }
+
+    qint32 slotCount = 0;
+    stream >> slotCount;
+    for (qint32 i = 0; i < slotCount && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray signature;
+        QByteArray returnType;
+        stream >> signature >> returnType;
+        QMetaMethodBuilder methodBuilder = builder.addSlot(signature);
+        methodBuilder.setReturnType(returnType);
+        methodBuilder.setAttributes(QMetaMethod::Scriptable);
+    }
+
+    qint32 propertyCount = 0;
+    stream >> propertyCount;
+    for (qint32 i = 0; i < propertyCount && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray name;
+        QByteArray typeName;
+        qint32 notifier = -1;
+        qint32 reader = -1;
+        qint32 writer = -1;
+        stream >> name >> typeName >> notifier >> reader >> writer;
+        QMetaPropertyBuilder propertyBuilder = builder.addProperty(name, typeName, notifier);
+        if (writer == -1)
+            propertyBuilder.setWritable(false);
+        if (notifier == -1)
+            propertyBuilder.setConstant(true);
+        m_propertySlots[QString::fromUtf8(name)] = qMakePair(int(reader), int(writer));
+    }
+
+    m_metaObject.reset(builder.toMetaObject());
+}
+
+void DosQMetaObject::serialize(QDataStream &stream) const
+{
+    const QMetaObject *result = metaObject();
+    stream << QByteArray(result->className());
+
+    // The signals precede the slots, as in createMetaObject()
+    const int methodOffset = result->methodOffset();
+    const int methodCount = result->methodCount() - methodOffset;
+    qint32 signalCount = 0;
+    while (signalCount < methodCount && result->method(methodOffset + signalCount).methodType() == QMetaMethod::Signal)
+        ++signalCount;
+
+    stream << signalCount;
+    for (int i = 0; i < signalCount; ++i) {
+        const QMetaMethod method = result->method(methodOffset + i);
+        stream << method.methodSignature() << method.parameterNames();
+    }
+
+    stream << qint32(methodCount - signalCount);
+    for (int i = signalCount; i < methodCount; ++i) {
+        const QMetaMethod method = result->method(methodOffset + i);
+        stream << method.methodSignature() << QByteArray(method.typeName());
+    }
+
+    const int propertyOffset = result->propertyOffset();
+    stream << qint32(result->propertyCount() - propertyOffset);
+    for (int i = propertyOffset; i < result->propertyCount(); ++i) {
+        const QMetaProperty property = result->property(i);
+        const QPair<int, int> slotIndexes = m_propertySlots.value(QString::fromUtf8(property.name()), qMakePair(-1, -1));
+        const qint32 notifier = property.hasNotifySignal() ? property.notifySignalIndex() - methodOffset : -1;
+        stream << QByteArray(property.name()) << QByteArray(property.typeName()) << notifier
+               << qint32(slotIndexes.first) << qint32(slotIndexes.second);
+    }
+}
+
 QMetaObject *DosQMetaObject::createMetaObject(const QString &className,
                                               const SignalDefinitions &signalDefinitions,
                                               const SlotDefinitions &slotDefinitions,
@@ -227,4 +329,92 @@ const DosIQMetaObject *DosQMetaObject::superClassDosMetaObject() const
     return m_superClassDosMetaObject.get();
 }
 
+const DosIQMetaObjectPtr &baseMetaObject(DosQMetaObjectBase base)
+{
+    // Shared so that the metaobjects of the subclasses can be cached and serialized
+    static const DosIQMetaObjectPtr object = std::make_shared<DosQObjectMetaObject>();
+    static const DosIQMetaObjectPtr itemModel = std::make_shared<DosQAbstractItemModelMetaObject>();
+    static const DosIQMetaObjectPtr listModel = std::make_shared<DosQAbstractListModelMetaObject>();
+    static const DosIQMetaObjectPtr tableModel = std::make_shared<DosQAbstractTableModelMetaObject>();
+    switch (base) {
+    case DosQMetaObjectBase::ItemModel:
+        return itemModel;
+    case DosQMetaObjectBase::ListModel:
+        return listModel;
+    case DosQMetaObjectBase::TableModel:
+        return tableModel;
+    default:
+        return object;
+    }
+}
+
+QByteArray serializeMetaObjects(const std::vector<DosIQMetaObjectPtr> &metaObjects)
+{
+    const DosQMetaObjectBase bases[] = { DosQMetaObjectBase::Object, DosQMetaObjectBase::ItemModel,
+                                         DosQMetaObjectBase::ListModel, DosQMetaObjectBase::TableModel };
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setVersion(TableStreamVersion);
+    stream << TableMagic << TableVersion << quint32(QT_VERSION >> 16) << qint32(metaObjects.size());
+
+    for (size_t i = 0; i < metaObjects.size(); ++i) {
+        auto metaObject = dynamic_cast<const DosQMetaObject *>(metaObjects[i].get());
+        if (!metaObject)
+            return QByteArray();
+
+        const DosIQMetaObject *superClass = metaObject->superClassDosMetaObject();
+        qint32 superClassIndex = static_cast<qint32>(metaObjects.size());
+        for (size_t j = 0; j < i; ++j) {
+            if (metaObjects[j].get() == superClass)
+                superClassIndex = static_cast<qint32>(j);
+        }
+        for (DosQMetaObjectBase base : bases) {
+            if (baseMetaObject(base).get() == superClass)
+                superClassIndex = encodeBase(base);
+        }
+        if (superClassIndex == static_cast<qint32>(metaObjects.size()))
+            return QByteArray();
+
+        stream << superClassIndex;
+        metaObject->serialize(stream);
+    }
+
+    return result;
+}
+
+std::vector<DosIQMetaObjectPtr> deserializeMetaObjects(const QByteArray &table, int count)
+{
+    QDataStream stream(table);
+    stream.setVersion(TableStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 qtVersion = 0;
+    qint32 tableCount = 0;
+    stream >> magic >> version >> qtVersion >> tableCount;
+    // Each metaobject takes at least the index of its superclass thus the table size bounds their number
+    if (stream.status() != QDataStream::Ok || magic != TableMagic || version != TableVersion
+            || qtVersion != quint32(QT_VERSION >> 16) || tableCount != count
+            || count > table.size() / int(sizeof(qint32)))
+        return std::vector<DosIQMetaObjectPtr>();
+
+    std::vector<DosIQMetaObjectPtr> result;
+    result.reserve(static_cast<size_t>(count));
+    for (qint32 i = 0; i < count; ++i) {
+        qint32 superClassIndex = 0;
+        stream >> superClassIndex;
+        if (stream.status() != QDataStream::Ok || superClassIndex >= i || superClassIndex < encodeBase(DosQMetaObjectBase::TableModel))
+            return std::vector<DosIQMetaObjectPtr>();
+
+        const DosIQMetaObjectPtr &superClass = superClassIndex >= 0
+                                               ? result[static_cast<size_t>(superClassIndex)]
+                                               : baseMetaObject(static_cast<DosQMetaObjectBase>(-1 - superClassIndex));
+        auto metaObject = std::make_shared<DosQMetaObject>(superClass, stream);
+        if (stream.status() != QDataStream::Ok)
+            return std::vector<DosIQMetaObjectPtr>();
+        result.push_back(std::move(metaObject));
+    }
+
+    return result;
+}
+
 } // namespace DOS
@@ -0,0 +1,335 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQMetaObjectCache.h"
+#include "DOtherSide/DosQMetaObject.h"
+
+// std
+#include <algorithm>
+#include <future>
+// Qt
+#include <QtCore/QThread>
+
+namespace {
+
+/// Below this number of missing metaobjects they're built on the calling thread
+const int ParallelThreshold = 32;
+
+/// Convert UTF-8 strings to QString sharing the data of equal strings
+class StringInterner
+{
+public:
+    QString operator()(const char *value)
+    {
+        if (!value)
+            return QString();
+        const QByteArray key = QByteArray::fromRawData(value, static_cast<int>(qstrlen(value)));
+        auto it = m_strings.constFind(key);
+        if (it != m_strings.constEnd())
+            return it.value();
+        QString result = QString::fromUtf8(value);
+        m_strings.insert(QByteArray(value), result);
+        return result;
+    }
+
+private:
+    QHash<QByteArray, QString> m_strings;
+};
+
+std::vector<DOS::ParameterDefinition> convert(StringInterner &intern, const ::ParameterDefinition *parameters, int count)
+{
+    std::vector<DOS::ParameterDefinition> result;
+    result.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+        result.emplace_back(intern(parameters[i].name), static_cast<QMetaType::Type>(parameters[i].metaType));
+    return result;
+}
+
+DOS::SignalDefinitions convert(StringInterner &intern, const ::SignalDefinitions &definitions)
+{
+    DOS::SignalDefinitions result;
+    result.reserve(static_cast<size_t>(definitions.count));
+    for (int i = 0; i < definitions.count; ++i) {
+        const ::SignalDefinition &signal = definitions.definitions[i];
+        result.emplace_back(intern(signal.name), convert(intern, signal.parameters, signal.parametersCount));
+    }
+    return result;
+}
+
+DOS::SlotDefinitions convert(StringInterner &intern, const ::SlotDefinitions &definitions)
+{
+    DOS::SlotDefinitions result;
+    result.reserve(static_cast<size_t>(definitions.count));
+    for (int i = 0; i < definitions.count; ++i) {
+        const ::SlotDefinition &slot = definitions.definitions[i];
+        result.emplace_back(intern(slot.name),
+                            static_cast<QMetaType::Type>(slot.returnMetaType),
+                            convert(intern, slot.parameters, slot.parametersCount));
+    }
+    return result;
+}
+
+DOS::PropertyDefinitions convert(StringInterner &intern, const ::PropertyDefinitions &definitions)
+{
+    DOS::PropertyDefinitions result;
+    result.reserve(static_cast<size_t>(definitions.count));
+    for (int i = 0; i < definitions.count; ++i) {
+        const ::PropertyDefinition &property = definitions.definitions[i];
+        result.emplace_back(intern(property.name),
+                            static_cast<QMetaType::Type>(property.propertyMetaType),
+                            intern(property.readSlot),
+                            intern(property.writeSlot),
+                            intern(property.notifySignal));
+    }
+    return result;
+}
+
+/// Call function(first, last) on consecutive chunks of [0, count) in parallel
+template<typename Function>
+void parallelFor(int count, const Function &function)
+{
+    const int chunks = count < ParallelThreshold ? 1 : std::max(1, QThread::idealThreadCount());
+    const int chunkSize = (count + chunks - 1) / chunks;
+    std::vector<std::future<void>> futures;
+    for (int first = chunkSize; first < count; first += chunkSize)
+        futures.push_back(std::async(std::launch::async, function, first, std::min(count, first + chunkSize)));
+    function(0, std::min(count, chunkSize));
+    for (auto &future : futures)
+        future.get();
+}
+
+void appendString(QByteArray &key, const char *value)
+{
+    if (value)
+        key.append(value);
+    key.append('\0');
+}
+
+void appendInt(QByteArray &key, int value)
+{
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void appendParameters(QByteArray &key, int count, const ::ParameterDefinition *parameters)
+{
+    appendInt(key, count);
+    for (int i = 0; i < count; ++i) {
+        appendString(key, parameters[i].name);
+        appendInt(key, parameters[i].metaType);
+    }
+}
+
+}
+
+namespace DOS {
+
+DosIQMetaObjectPtr DosQMetaObjectCache::metaObject(const DosIQMetaObjectPtr &superClass,
+                                                   const char *className,
+                                                   const ::SignalDefinitions &signalDefinitions,
+                                                   const ::SlotDefinitions &slotDefinitions,
+                                                   const ::PropertyDefinitions &propertyDefinitions)
+{
+    const QByteArray entryKey = key(superClass, className, signalDefinitions, slotDefinitions, propertyDefinitions);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DosIQMetaObjectPtr result = m_entries.value(entryKey).lock();
+    if (result) {
+        ++m_hits;
+        return result;
+    }
+
+    ++m_misses;
+    result = std::make_shared<DosQMetaObject>(superClass,
+                                              QString::fromUtf8(className),
+                                              toVector(signalDefinitions),
+                                              toVector(slotDefinitions),
+                                              toVector(propertyDefinitions));
+    m_entries.insert(entryKey, result);
+    if (m_entries.size() >= m_removeExpiredThreshold)
+        removeExpired();
+    return result;
+}
+
+std::vector<DosIQMetaObjectPtr> DosQMetaObjectCache::metaObjects(const ::DosQMetaObjectDescriptor *descriptors, int count)
+{
+    // Group the descriptors by inheritance depth so that every superclass is ready before its subclasses
+    std::vector<std::vector<int>> levels;
+    std::vector<size_t> depths(static_cast<size_t>(count), 0);
+    for (int i = 0; i < count; ++i) {
+        const ::DosQMetaObjectDescriptor &descriptor = descriptors[i];
+        if (descriptor.superClassIndex >= i || (descriptor.superClassIndex < 0 && !descriptor.superClassMetaObject))
+            return {};
+        const size_t depth = descriptor.superClassIndex < 0 ? 0 : depths[static_cast<size_t>(descriptor.superClassIndex)] + 1;
+        depths[static_cast<size_t>(i)] = depth;
+        if (depth == levels.size())
+            levels.emplace_back();
+        levels[depth].push_back(i);
+    }
+
+    struct Build {
+        int index;
+        QByteArray key;
+        DosIQMetaObjectPtr superClass;
+        QString className;
+        SignalDefinitions signalDefinitions;
+        SlotDefinitions slotDefinitions;
+        PropertyDefinitions propertyDefinitions;
+        DosIQMetaObjectPtr metaObject;
+    };
+
+    std::vector<DosIQMetaObjectPtr> result(static_cast<size_t>(count));
+    StringInterner intern;
+
+    for (const std::vector<int> &level : levels) {
+        std::vector<Build> builds;
+        builds.reserve(level.size());
+        for (int i : level) {
+            const ::DosQMetaObjectDescriptor &descriptor = descriptors[i];
+            Build build;
+            build.index = i;
+            build.superClass = descriptor.superClassIndex >= 0
+                               ? result[static_cast<size_t>(descriptor.superClassIndex)]
+                               : static_cast<DosIQMetaObjectHolder *>(descriptor.superClassMetaObject)->data();
+            build.key = key(build.superClass, descriptor.className, descriptor.signalDefinitions,
+                            descriptor.slotDefinitions, descriptor.propertyDefinitions);
+            builds.push_back(std::move(build));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto last = std::remove_if(builds.begin(), builds.end(), [this, &result](const Build &build) {
+                DosIQMetaObjectPtr cached = m_entries.value(build.key).lock();
+                if (!cached)
+                    return false;
+                ++m_hits;
+                result[static_cast<size_t>(build.index)] = std::move(cached);
+                return true;
+            });
+            builds.erase(last, builds.end());
+        }
+
+        // Conversions share the interned names thus they're done on this thread
+        for (Build &build : builds) {
+            const ::DosQMetaObjectDescriptor &descriptor = descriptors[build.index];
+            build.className = intern(descriptor.className);
+            build.signalDefinitions = convert(intern, descriptor.signalDefinitions);
+            build.slotDefinitions = convert(intern, descriptor.slotDefinitions);
+            build.propertyDefinitions = convert(intern, descriptor.propertyDefinitions);
+        }
+
+        parallelFor(static_cast<int>(builds.size()), [&builds](int first, int last) {
+            for (int i = first; i < last; ++i) {
+                Build &build = builds[static_cast<size_t>(i)];
+                build.metaObject = std::make_shared<DosQMetaObject>(build.superClass, build.className,
+                                                                    build.signalDefinitions,
+                                                                    build.slotDefinitions,
+                                                                    build.propertyDefinitions);
+            }
+        });
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Build &build : builds) {
+            // Equal descriptors in the batch or a concurrent request may have inserted it meanwhile
+            DosIQMetaObjectPtr cached = m_entries.value(build.key).lock();
+            if (cached) {
+                ++m_hits;
+                result[static_cast<size_t>(build.index)] = std::move(cached);
+            } else {
+                ++m_misses;
+                m_entries.insert(build.key, build.metaObject);
+                result[static_cast<size_t>(build.index)] = std::move(build.metaObject);
+            }
+        }
+        if (m_entries.size() >= m_removeExpiredThreshold)
+            removeExpired();
+    }
+
+    return result;
+}
+
+int DosQMetaObjectCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+int DosQMetaObjectCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+DosQMetaObjectCache &DosQMetaObjectCache::instance()
+{
+    static DosQMetaObjectCache result;
+    return result;
+}
+
+QByteArray DosQMetaObjectCache::key(const DosIQMetaObjectPtr &superClass,
+                                    const char *className,
+                                    const ::SignalDefinitions &signalDefinitions,
+                                    const ::SlotDefinitions &slotDefinitions,
+                                    const ::PropertyDefinitions &propertyDefinitions)
+{
+    // The superclass is identified by address since the cached DosQMetaObject keeps it alive
+    const DosIQMetaObject *superClassAddress = superClass.get();
+    QByteArray result(reinterpret_cast<const char *>(&superClassAddress), sizeof(superClassAddress));
+    appendString(result, className);
+
+    appendInt(result, signalDefinitions.count);
+    for (int i = 0; i < signalDefinitions.count; ++i) {
+        const ::SignalDefinition &signal = signalDefinitions.definitions[i];
+        appendString(result, signal.name);
+        appendParameters(result, signal.parametersCount, signal.parameters);
+    }
+
+    appendInt(result, slotDefinitions.count);
+    for (int i = 0; i < slotDefinitions.count; ++i) {
+        const ::SlotDefinition &slot = slotDefinitions.definitions[i];
+        appendString(result, slot.name);
+        appendInt(result, slot.returnMetaType);
+        appendParameters(result, slot.parametersCount, slot.parameters);
+    }
+
+    appendInt(result, propertyDefinitions.count);
+    for (int i = 0; i < propertyDefinitions.count; ++i) {
+        const ::PropertyDefinition &property = propertyDefinitions.definitions[i];
+        appendString(result, property.name);
+        appendInt(result, property.propertyMetaType);
+        appendString(result, property.readSlot);
+        appendString(result, property.writeSlot);
+        appendString(result, property.notifySignal);
+    }
+
+    return result;
+}
+
+void DosQMetaObjectCache::removeExpired()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it.value().expired())
+            it = m_entries.erase(it);
+        else
+            ++it;
+    }
+    // Scan again once the live entries have doubled, keeping the cost amortized
+    m_removeExpiredThreshold = std::max(64, 2 * int(m_entries.size()));
+}
+
+} // namespace DOS
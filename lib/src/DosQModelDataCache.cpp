@@ -0,0 +1,206 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQModelDataCache.h"
+
+// std
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+int estimatedCost(const QVariant &value)
+{
+    // Key, value and the bookkeeping of the QCache node
+    int result = sizeof(DOS::DosQModelDataCacheKey) + sizeof(QVariant) + 4 * sizeof(void *);
+    if (DOS::isString(value))
+        result += value.toString().size() * sizeof(QChar);
+    return result;
+}
+
+}
+
+namespace DOS {
+
+bool operator==(const DosQModelDataCacheKey &lhs, const DosQModelDataCacheKey &rhs)
+{
+    return lhs.row == rhs.row
+           && lhs.column == rhs.column
+           && lhs.internalId == rhs.internalId
+           && lhs.role == rhs.role;
+}
+
+HashValue qHash(const DosQModelDataCacheKey &key, HashValue seed)
+{
+    HashValue result = seed;
+    result = 31 * result + ::qHash(key.row);
+    result = 31 * result + ::qHash(key.column);
+    result = 31 * result + ::qHash(key.internalId);
+    result = 31 * result + ::qHash(key.role);
+    return result;
+}
+
+DosQModelDataCache::DosQModelDataCache(int budget)
+    : m_values(budget)
+{}
+
+int DosQModelDataCache::budget() const
+{
+    return static_cast<int>(m_values.maxCost());
+}
+
+void DosQModelDataCache::setBudget(int budget)
+{
+    m_values.setMaxCost(budget);
+}
+
+bool DosQModelDataCache::lookup(const DosQModelDataCacheKey &key, QVariant *result) const
+{
+    DosQModelDataCacheKey stored;
+    if (!storedKey(key, &stored))
+        return false;
+    const QVariant *value = m_values.object(stored);
+    if (!value)
+        return false;
+    *result = *value;
+    return true;
+}
+
+void DosQModelDataCache::insert(const DosQModelDataCacheKey &key, const QVariant &value)
+{
+    if (key.row < 0 || key.column < 0)
+        return;
+    reserveIds(m_rowIds, key.row + 1);
+    reserveIds(m_columnIds, key.column + 1);
+    DosQModelDataCacheKey stored;
+    storedKey(key, &stored);
+    m_values.insert(stored, new QVariant(value), estimatedCost(value));
+}
+
+void DosQModelDataCache::invalidateRows(int first, int last)
+{
+    renewIds(m_rowIds, first, last);
+}
+
+void DosQModelDataCache::insertRows(int first, int count)
+{
+    insertIds(m_rowIds, first, count);
+}
+
+void DosQModelDataCache::removeRows(int first, int count)
+{
+    removeIds(m_rowIds, first, count);
+}
+
+void DosQModelDataCache::moveRows(int first, int last, int destination)
+{
+    moveIds(m_rowIds, first, last, destination);
+}
+
+void DosQModelDataCache::insertColumns(int first, int count)
+{
+    insertIds(m_columnIds, first, count);
+}
+
+void DosQModelDataCache::removeColumns(int first, int count)
+{
+    removeIds(m_columnIds, first, count);
+}
+
+void DosQModelDataCache::moveColumns(int first, int last, int destination)
+{
+    moveIds(m_columnIds, first, last, destination);
+}
+
+void DosQModelDataCache::clear()
+{
+    m_values.clear();
+    m_rowIds.clear();
+    m_columnIds.clear();
+    m_nextId = 0;
+}
+
+bool DosQModelDataCache::storedKey(const DosQModelDataCacheKey &key, DosQModelDataCacheKey *result) const
+{
+    if (key.row < 0 || key.column < 0
+            || key.row >= static_cast<int>(m_rowIds.size()) || key.column >= static_cast<int>(m_columnIds.size()))
+        return false;
+    *result = DosQModelDataCacheKey {static_cast<int>(m_rowIds[key.row]), static_cast<int>(m_columnIds[key.column]),
+                                     key.internalId, key.role};
+    return true;
+}
+
+void DosQModelDataCache::reserveIds(std::vector<quint32> &ids, int size)
+{
+    while (static_cast<int>(ids.size()) < size)
+        ids.push_back(nextId());
+}
+
+void DosQModelDataCache::renewIds(std::vector<quint32> &ids, int first, int last)
+{
+    last = std::min(last, static_cast<int>(ids.size()) - 1);
+    for (int i = std::max(first, 0); i <= last; ++i)
+        ids[i] = nextId();
+}
+
+void DosQModelDataCache::insertIds(std::vector<quint32> &ids, int first, int count)
+{
+    if (first < 0 || first >= static_cast<int>(ids.size()) || count <= 0)
+        return;
+    std::vector<quint32> inserted(count);
+    for (quint32 &id : inserted)
+        id = nextId();
+    ids.insert(ids.begin() + first, inserted.begin(), inserted.end());
+}
+
+void DosQModelDataCache::removeIds(std::vector<quint32> &ids, int first, int count)
+{
+    const int size = static_cast<int>(ids.size());
+    if (first < 0 || first >= size || count <= 0)
+        return;
+    ids.erase(ids.begin() + first, ids.begin() + std::min(first + count, size));
+}
+
+void DosQModelDataCache::moveIds(std::vector<quint32> &ids, int first, int last, int destination)
+{
+    if (first < 0 || last < first || (destination >= first && destination <= last + 1))
+        return;
+    reserveIds(ids, std::max(last + 1, destination));
+    if (destination > last)
+        std::rotate(ids.begin() + first, ids.begin() + last + 1, ids.begin() + destination);
+    else
+        std::rotate(ids.begin() + destination, ids.begin() + first, ids.begin() + last + 1);
+}
+
+quint32 DosQModelDataCache::nextId()
+{
+    // Ids are never reused otherwise values of removed positions could be reached again.
+    // Once they're exhausted the values are dropped and the positions numbered again
+    if (m_nextId == std::numeric_limits<quint32>::max()) {
+        m_values.clear();
+        m_nextId = 0;
+        for (quint32 &id : m_rowIds)
+            id = m_nextId++;
+        for (quint32 &id : m_columnIds)
+            id = m_nextId++;
+    }
+    return m_nextId++;
+}
+
+} // namespace DOS
@@ -0,0 +1,209 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQModelDiff.h"
+
+// std
+#include <algorithm>
+
+// Qt
+#include <QtCore/QHash>
+
+namespace DOS {
+
+DosQModelDiff::DosQModelDiff(const std::vector<quint64> &oldKeys,
+                             const std::vector<quint64> &oldHashes,
+                             const std::vector<quint64> &newKeys,
+                             const std::vector<quint64> &newHashes)
+    : m_rowMap(oldKeys.size(), -1)
+{
+    const int newCount = static_cast<int>(newKeys.size());
+
+    QHash<quint64, int> newRows;
+    newRows.reserve(newCount);
+    for (int row = 0; row < newCount; ++row) {
+        if (newRows.contains(newKeys[row])) {
+            m_requiresReset = true;
+            return;
+        }
+        newRows.insert(newKeys[row], row);
+    }
+
+    std::vector<int> newToOld(newCount, -1);
+    std::vector<int> keptRows;
+    keptRows.reserve(std::min(oldKeys.size(), newKeys.size()));
+    for (size_t row = 0; row < oldKeys.size(); ++row) {
+        auto it = newRows.constFind(oldKeys[row]);
+        if (it == newRows.constEnd())
+            continue;
+        if (newToOld[it.value()] >= 0) {
+            m_requiresReset = true;
+            return;
+        }
+        newToOld[it.value()] = static_cast<int>(row);
+        m_rowMap[row] = it.value();
+        keptRows.push_back(it.value());
+    }
+
+    computeRemovals();
+    computeMoves(std::move(keptRows), newCount);
+    computeInsertions(newToOld);
+    computeChanges(newToOld, oldHashes, newHashes);
+}
+
+bool DosQModelDiff::requiresReset() const
+{
+    return m_requiresReset;
+}
+
+const std::vector<int> &DosQModelDiff::rowMap() const
+{
+    return m_rowMap;
+}
+
+const std::vector<DosQModelDiffOperation> &DosQModelDiff::operations() const
+{
+    return m_operations;
+}
+
+void DosQModelDiff::computeRemovals()
+{
+    // Bottom up so that the rows above a removed range keep their numbering
+    for (int row = static_cast<int>(m_rowMap.size()) - 1; row >= 0;) {
+        if (m_rowMap[row] >= 0) {
+            --row;
+            continue;
+        }
+        const int last = row;
+        while (row >= 0 && m_rowMap[row] < 0)
+            --row;
+        append(DosQModelDiffOperation::Remove, row + 1, last);
+    }
+}
+
+void DosQModelDiff::computeMoves(std::vector<int> rows, int newCount)
+{
+    // The longest increasing subsequence of the kept rows stays in place,
+    // every other row is moved next to its predecessor in the new order
+    const int count = static_cast<int>(rows.size());
+    std::vector<int> tails;
+    std::vector<int> previous(count, -1);
+    for (int i = 0; i < count; ++i) {
+        auto it = std::lower_bound(tails.begin(), tails.end(), rows[i], [&rows](int position, int value) {
+            return rows[position] < value;
+        });
+        if (it != tails.begin())
+            previous[i] = *(it - 1);
+        if (it == tails.end())
+            tails.push_back(i);
+        else
+            *it = i;
+    }
+
+    const int moved = count - static_cast<int>(tails.size());
+    if (moved == 0)
+        return;
+    if (moved > MaxMoves) {
+        append(DosQModelDiffOperation::Layout, 0, count - 1);
+        return;
+    }
+
+    std::vector<bool> placed(newCount, false);
+    for (int i = tails.back(); i >= 0; i = previous[i])
+        placed[rows[i]] = true;
+
+    std::vector<int> target = rows;
+    std::sort(target.begin(), target.end());
+
+    for (int t = 0; t < count; ++t) {
+        if (placed[target[t]])
+            continue;
+
+        const int first = static_cast<int>(std::find(rows.begin(), rows.end(), target[t]) - rows.begin());
+        int length = 1;
+        while (t + length < count && first + length < count
+               && !placed[target[t + length]] && rows[first + length] == target[t + length])
+            ++length;
+
+        const int destination = t == 0 ? 0 : static_cast<int>(std::find(rows.begin(), rows.end(), target[t - 1]) - rows.begin()) + 1;
+        if (destination < first) {
+            append(DosQModelDiffOperation::Move, first, first + length - 1, destination);
+            std::rotate(rows.begin() + destination, rows.begin() + first, rows.begin() + first + length);
+        } else if (destination > first + length) {
+            append(DosQModelDiffOperation::Move, first, first + length - 1, destination);
+            std::rotate(rows.begin() + first, rows.begin() + first + length, rows.begin() + destination);
+        }
+
+        for (int i = 0; i < length; ++i)
+            placed[target[t + i]] = true;
+        t += length - 1;
+    }
+}
+
+void DosQModelDiff::computeInsertions(const std::vector<int> &newToOld)
+{
+    // Top down so that every inserted row lands directly at its final position
+    const int count = static_cast<int>(newToOld.size());
+    for (int row = 0; row < count;) {
+        if (newToOld[row] >= 0) {
+            ++row;
+            continue;
+        }
+        const int first = row;
+        while (row < count && newToOld[row] < 0)
+            ++row;
+        append(DosQModelDiffOperation::Insert, first, row - 1);
+    }
+}
+
+void DosQModelDiff::computeChanges(const std::vector<int> &newToOld,
+                                   const std::vector<quint64> &oldHashes,
+                                   const std::vector<quint64> &newHashes)
+{
+    // Without hashes rows with the same key are considered unchanged
+    if (oldHashes.size() != m_rowMap.size() || newHashes.size() != newToOld.size())
+        return;
+
+    const int count = static_cast<int>(newToOld.size());
+    auto changed = [&](int row) {
+        return newToOld[row] >= 0 && oldHashes[newToOld[row]] != newHashes[row];
+    };
+    for (int row = 0; row < count;) {
+        if (!changed(row)) {
+            ++row;
+            continue;
+        }
+        const int first = row;
+        while (row < count && changed(row))
+            ++row;
+        append(DosQModelDiffOperation::Change, first, row - 1);
+    }
+}
+
+void DosQModelDiff::append(DosQModelDiffOperation::Type type, int first, int last, int destination)
+{
+    DosQModelDiffOperation operation;
+    operation.type = type;
+    operation.first = first;
+    operation.last = last;
+    operation.destination = destination;
+    m_operations.push_back(operation);
+}
+
+} // namespace DOS
@@ -0,0 +1,46 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQModelIndexValue.h"
+#include "DOtherSide/DosIQAbstractItemModelImpl.h"
+
+namespace DOS {
+
+DosModelIndexValue invalidModelIndexValue()
+{
+    return DosModelIndexValue {-1, -1, 0, nullptr};
+}
+
+DosModelIndexValue toModelIndexValue(const QModelIndex &index)
+{
+    if (!index.isValid())
+        return invalidModelIndexValue();
+    auto model = const_cast<QAbstractItemModel *>(index.model());
+    return DosModelIndexValue {index.row(), index.column(), static_cast<uintptr_t>(index.internalId()), static_cast<QObject *>(model)};
+}
+
+QModelIndex toModelIndex(const DosModelIndexValue &value)
+{
+    if (!value.model || value.row < 0 || value.column < 0)
+        return QModelIndex();
+    auto model = toModelImpl(static_cast<QObject *>(value.model));
+    return model ? model->publicCreateIndex(value.row, value.column, reinterpret_cast<void *>(value.internalId)) : QModelIndex();
+}
+
+} // namespace DOS
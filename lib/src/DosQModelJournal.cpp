@@ -0,0 +1,57 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQModelJournal.h"
+
+// std
+#include <algorithm>
+
+namespace DOS {
+
+DosQModelJournal::~DosQModelJournal()
+{
+    take();
+}
+
+bool DosQModelJournal::push(std::unique_ptr<DosQModelJournalEntry> entry)
+{
+    DosQModelJournalEntry *node = entry.release();
+    DosQModelJournalEntry *head = m_head.load(std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+    return head == nullptr;
+}
+
+std::vector<std::unique_ptr<DosQModelJournalEntry>> DosQModelJournal::take()
+{
+    // Entries are linked newest first
+    std::vector<std::unique_ptr<DosQModelJournalEntry>> result;
+    DosQModelJournalEntry *node = m_head.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        DosQModelJournalEntry *next = node->next;
+        node->next = nullptr;
+        result.emplace_back(node);
+        node = next;
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+} // namespace DOS
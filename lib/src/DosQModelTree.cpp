@@ -0,0 +1,222 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQModelTree.h"
+
+// std
+#include <cstdlib>
+
+// Qt
+#include <QtCore/QSet>
+
+namespace DOS {
+
+DosQModelTree::DosQModelTree()
+    : m_nodes(1)
+{}
+
+int DosQModelTree::node(quintptr payload) const
+{
+    return m_nodeByPayload.value(payload, static_cast<int>(NoNode));
+}
+
+quintptr DosQModelTree::payload(int node) const
+{
+    return m_nodes[node].payload;
+}
+
+int DosQModelTree::parent(int node) const
+{
+    return m_nodes[node].parent;
+}
+
+int DosQModelTree::childCount(int node) const
+{
+    return m_nodes[node].childCount;
+}
+
+int DosQModelTree::child(int node, int row) const
+{
+    const Node &parent = m_nodes[node];
+    if (row < 0 || row >= parent.childCount)
+        return NoNode;
+
+    // Start from the closest of the first child, the last child and the cursor
+    int current = parent.firstChild;
+    int currentRow = 0;
+    if (parent.childCount - 1 - row < row) {
+        current = parent.lastChild;
+        currentRow = parent.childCount - 1;
+    }
+    if (parent.cursorNode != NoNode && std::abs(parent.cursorRow - row) < std::abs(currentRow - row)) {
+        current = parent.cursorNode;
+        currentRow = parent.cursorRow;
+    }
+
+    for (; currentRow < row; ++currentRow)
+        current = m_nodes[current].nextSibling;
+    for (; currentRow > row; --currentRow)
+        current = m_nodes[current].previousSibling;
+
+    parent.cursorNode = current;
+    parent.cursorRow = row;
+    return current;
+}
+
+int DosQModelTree::row(int node) const
+{
+    const Node &current = m_nodes[node];
+    if (current.parent == NoNode)
+        return 0;
+    const Node &parent = m_nodes[current.parent];
+    if (parent.rowsDirty)
+        renumber(parent);
+    return current.row;
+}
+
+bool DosQModelTree::canInsert(int parent, int row, const quintptr *payloads, int count) const
+{
+    if (parent < 0 || parent >= static_cast<int>(m_nodes.size()) || count < 0)
+        return false;
+    if (row < 0 || row > m_nodes[parent].childCount)
+        return false;
+
+    QSet<quintptr> inserted;
+    for (int i = 0; i < count; ++i) {
+        if (m_nodeByPayload.contains(payloads[i]) || inserted.contains(payloads[i]))
+            return false;
+        inserted.insert(payloads[i]);
+    }
+    return true;
+}
+
+bool DosQModelTree::insert(int parent, int row, const quintptr *payloads, int count)
+{
+    if (!canInsert(parent, row, payloads, count))
+        return false;
+
+    // Indexes are used because allocating may reallocate the arena
+    const int next = row == m_nodes[parent].childCount ? static_cast<int>(NoNode) : child(parent, row);
+    int previous = next == NoNode ? m_nodes[parent].lastChild : m_nodes[next].previousSibling;
+    for (int i = 0; i < count; ++i) {
+        const int current = allocate();
+        Node &node = m_nodes[current];
+        node.payload = payloads[i];
+        node.parent = parent;
+        node.previousSibling = previous;
+        node.nextSibling = next;
+        node.row = row + i;
+        if (previous == NoNode)
+            m_nodes[parent].firstChild = current;
+        else
+            m_nodes[previous].nextSibling = current;
+        m_nodeByPayload.insert(payloads[i], current);
+        previous = current;
+    }
+    if (next == NoNode)
+        m_nodes[parent].lastChild = previous;
+    else
+        m_nodes[next].previousSibling = previous;
+
+    Node &node = m_nodes[parent];
+    node.childCount += count;
+    node.cursorNode = NoNode;
+    // Appended rows are numbered on insertion
+    node.rowsDirty = node.rowsDirty || next != NoNode;
+    return true;
+}
+
+bool DosQModelTree::remove(int parent, int row, int count)
+{
+    if (parent < 0 || parent >= static_cast<int>(m_nodes.size()) || count < 0)
+        return false;
+    const int childCount = m_nodes[parent].childCount;
+    if (row < 0 || row + count > childCount)
+        return false;
+    if (count == 0)
+        return true;
+
+    const int first = child(parent, row);
+    const int previous = m_nodes[first].previousSibling;
+    int current = first;
+    for (int i = 0; i < count; ++i) {
+        const int next = m_nodes[current].nextSibling;
+        release(current);
+        current = next;
+    }
+
+    if (previous == NoNode)
+        m_nodes[parent].firstChild = current;
+    else
+        m_nodes[previous].nextSibling = current;
+    if (current == NoNode)
+        m_nodes[parent].lastChild = previous;
+    else
+        m_nodes[current].previousSibling = previous;
+
+    Node &node = m_nodes[parent];
+    node.childCount -= count;
+    node.cursorNode = NoNode;
+    node.rowsDirty = node.rowsDirty || current != NoNode;
+    return true;
+}
+
+void DosQModelTree::clear()
+{
+    m_nodes.assign(1, Node());
+    m_nodeByPayload.clear();
+    m_freeNode = NoNode;
+}
+
+int DosQModelTree::allocate()
+{
+    if (m_freeNode == NoNode) {
+        m_nodes.emplace_back();
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+    const int result = m_freeNode;
+    m_freeNode = m_nodes[result].nextSibling;
+    m_nodes[result] = Node();
+    return result;
+}
+
+void DosQModelTree::release(int node)
+{
+    std::vector<int> pending { node };
+    while (!pending.empty()) {
+        const int current = pending.back();
+        pending.pop_back();
+        for (int child = m_nodes[current].firstChild; child != NoNode; child = m_nodes[child].nextSibling)
+            pending.push_back(child);
+        m_nodeByPayload.remove(m_nodes[current].payload);
+        m_nodes[current].parent = NoNode;
+        m_nodes[current].nextSibling = m_freeNode;
+        m_freeNode = current;
+    }
+}
+
+void DosQModelTree::renumber(const Node &node) const
+{
+    int row = 0;
+    for (int child = node.firstChild; child != NoNode; child = m_nodes[child].nextSibling)
+        m_nodes[child].row = row++;
+    node.rowsDirty = false;
+}
+
+} // namespace DOS
@@ -0,0 +1,63 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQObjectWrapper.h"
+
+namespace DOS {
+
+DosQObjectWrapper::DosQObjectWrapper(const DosQmlTypeRegistration &registration, QObject *parent)
+    : QObject(parent)
+    , m_registration(registration)
+    , m_dObject(nullptr)
+    , m_impl(nullptr)
+{
+    void *impl = nullptr;
+    m_registration.data.createDObject(m_registration.id, static_cast<QObject *>(this), &m_dObject, &impl);
+    m_impl = dynamic_cast<DosQObject *>(static_cast<QObject *>(impl));
+    Q_ASSERT(m_dObject);
+    Q_ASSERT(m_impl);
+}
+
+DosQObjectWrapper::~DosQObjectWrapper()
+{
+    m_registration.data.deleteDObject(m_registration.id, m_dObject);
+    m_dObject = nullptr;
+    delete dynamic_cast<QObject *>(m_impl);
+    m_impl = nullptr;
+}
+
+const QMetaObject *DosQObjectWrapper::metaObject() const
+{
+    Q_ASSERT(m_impl);
+    return m_impl->metaObject();
+}
+
+int DosQObjectWrapper::qt_metacall(QMetaObject::Call call, int index, void **args)
+{
+    Q_ASSERT(m_impl);
+    return m_impl->qt_metacall(call, index, args);
+}
+
+bool DosQObjectWrapper::emitSignal(QObject *, const QString &name, const std::vector<QVariant> &argumentsValues)
+{
+    Q_ASSERT(m_impl);
+    return m_impl->emitSignal(this, name, argumentsValues);
+}
+
+} // namespace DOS
@@ -0,0 +1,132 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQQmlComponentPool.h"
+
+// std
+#include <algorithm>
+// Qt
+#include <QtQml/QQmlEngine>
+#include <QtQuick/QQuickItem>
+
+namespace DOS {
+
+DosQQmlComponentPool::DosQQmlComponentPool(QQmlComponent *component, QQmlContext *context, int capacity,
+                                           DosQQmlComponentPoolRecycleCallback callback, void *callbackData)
+    : m_component(component)
+    , m_context(context)
+    , m_capacity(capacity)
+    , m_callback(callback)
+    , m_callbackData(callbackData)
+{}
+
+void DosQQmlComponentPool::fill()
+{
+    removeCompletedIncubators();
+    if (!m_component || !m_component->isReady())
+        return;
+
+    const int missing = m_capacity - static_cast<int>(m_objects.size() + m_incubators.size());
+    for (int i = 0; i < missing; ++i) {
+        m_incubators.emplace_back(new DosQQmlIncubator(&DosQQmlComponentPool::onIncubated, this));
+        m_component->create(*m_incubators.back(), m_context);
+    }
+}
+
+QObject *DosQQmlComponentPool::acquire()
+{
+    if (m_objects.empty()) {
+        // Finishing a pending incubation is cheaper than a creation from scratch
+        auto it = std::find_if(m_incubators.begin(), m_incubators.end(), [](const std::unique_ptr<DosQQmlIncubator> &incubator) {
+            return incubator->isLoading();
+        });
+        if (it != m_incubators.end())
+            (*it)->forceCompletion();
+    }
+
+    QObject *result = nullptr;
+    if (!m_objects.empty()) {
+        result = m_objects.back();
+        m_objects.pop_back();
+        result->setParent(nullptr);
+    } else if (m_component && m_component->isReady()) {
+        result = m_component->create(m_context);
+        if (!result)
+            return nullptr;
+        QQmlEngine::setObjectOwnership(result, QQmlEngine::CppOwnership);
+    }
+
+    if (auto item = qobject_cast<QQuickItem *>(result))
+        item->setVisible(true);
+    return result;
+}
+
+void DosQQmlComponentPool::release(QObject *object)
+{
+    if (isFull()) {
+        delete object;
+        return;
+    }
+    if (m_callback)
+        m_callback(m_callbackData, object);
+    store(object);
+}
+
+int DosQQmlComponentPool::available() const
+{
+    return static_cast<int>(m_objects.size());
+}
+
+void DosQQmlComponentPool::onIncubated(void *self, DosQObject *object)
+{
+    if (object)
+        static_cast<DosQQmlComponentPool *>(self)->store(static_cast<QObject *>(object));
+}
+
+bool DosQQmlComponentPool::isFull() const
+{
+    return static_cast<int>(m_objects.size()) >= m_capacity;
+}
+
+void DosQQmlComponentPool::store(QObject *object)
+{
+    // Incubations started by fill() can complete after release() filled the pool
+    if (isFull()) {
+        object->deleteLater();
+        return;
+    }
+
+    // Pooled objects are children of the pool thus they're deleted along with it
+    if (auto item = qobject_cast<QQuickItem *>(object)) {
+        item->setParentItem(nullptr);
+        item->setVisible(false);
+    }
+    object->setParent(this);
+    m_objects.push_back(object);
+}
+
+void DosQQmlComponentPool::removeCompletedIncubators()
+{
+    auto last = std::remove_if(m_incubators.begin(), m_incubators.end(), [](const std::unique_ptr<DosQQmlIncubator> &incubator) {
+        return incubator->isReady() || incubator->isError();
+    });
+    m_incubators.erase(last, m_incubators.end());
+}
+
+} // namespace DOS
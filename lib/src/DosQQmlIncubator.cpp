@@ -0,0 +1,72 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQQmlIncubator.h"
+
+// Qt
+#include <QtQml/QQmlEngine>
+
+namespace {
+
+/// The interval between two incubation slices, about one frame at 60Hz
+const int FrameInterval = 16;
+
+}
+
+namespace DOS {
+
+DosQQmlIncubator::DosQQmlIncubator(DosQQmlIncubatorCallback callback, void *callbackData)
+    : QQmlIncubator(QQmlIncubator::Asynchronous)
+    , m_callback(callback)
+    , m_callbackData(callbackData)
+{}
+
+void DosQQmlIncubator::statusChanged(Status status)
+{
+    if (status != Ready && status != Error)
+        return;
+    QObject *result = status == Ready ? object() : nullptr;
+    if (result)
+        QQmlEngine::setObjectOwnership(result, QQmlEngine::CppOwnership);
+    if (m_callback)
+        m_callback(m_callbackData, result);
+}
+
+DosQQmlIncubationController::DosQQmlIncubationController(int budget, QObject *parent)
+    : QObject(parent)
+    , m_budget(budget)
+{
+    m_timer.setInterval(FrameInterval);
+    QObject::connect(&m_timer, &QTimer::timeout, this, [this] { incubateFor(m_budget); });
+}
+
+void DosQQmlIncubationController::setBudget(int budget)
+{
+    m_budget = budget;
+}
+
+void DosQQmlIncubationController::incubatingObjectCountChanged(int count)
+{
+    if (count > 0 && !m_timer.isActive())
+        m_timer.start();
+    else if (count == 0)
+        m_timer.stop();
+}
+
+} // namespace DOS
@@ -0,0 +1,67 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQQmlPreloader.h"
+
+namespace DOS {
+
+DosQQmlPreloader::DosQQmlPreloader(QQmlEngine *engine, std::vector<QUrl> urls,
+                                   DosQQmlPreloadCallback callback, void *callbackData)
+    : QObject(engine)
+    , m_engine(engine)
+    , m_urls(std::move(urls))
+    , m_callback(callback)
+    , m_callbackData(callbackData)
+{}
+
+void DosQQmlPreloader::start()
+{
+    loadNext();
+}
+
+void DosQQmlPreloader::loadNext()
+{
+    if (m_current >= m_urls.size())
+        return;
+
+    auto component = new QQmlComponent(m_engine, this);
+    QObject::connect(component, &QQmlComponent::statusChanged, this, [this, component](QQmlComponent::Status status) {
+        onStatusChanged(component, status);
+    });
+    m_timer.start();
+    component->loadUrl(m_urls[m_current], QQmlComponent::Asynchronous);
+}
+
+void DosQQmlPreloader::onStatusChanged(QQmlComponent *component, QQmlComponent::Status status)
+{
+    if (status != QQmlComponent::Ready && status != QQmlComponent::Error)
+        return;
+
+    // Files are compiled one at a time so the elapsed time belongs only to this one
+    const double milliseconds = m_timer.nsecsElapsed() / 1000000.0;
+    QObject::disconnect(component, &QQmlComponent::statusChanged, this, nullptr);
+    if (m_callback)
+        m_callback(m_callbackData, static_cast<int>(m_current), status, milliseconds);
+    ++m_current;
+
+    // Cached files are ready within loadUrl() thus continue from the event loop to avoid recursion
+    QMetaObject::invokeMethod(this, [this] { loadNext(); }, Qt::QueuedConnection);
+}
+
+} // namespace DOS
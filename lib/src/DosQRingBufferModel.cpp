@@ -0,0 +1,236 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQRingBufferModel.h"
+
+// std
+#include <algorithm>
+
+// Qt
+#include <QtCore/QTimer>
+
+namespace {
+
+/// Interval between publishes of the staged rows, about one frame
+const int PublishInterval = 16;
+
+}
+
+namespace DOS {
+
+DosQRingBufferModel::DosQRingBufferModel(void *modelObject,
+                                         DosIQMetaObjectPtr metaObject,
+                                         DObjectCallback dObjectCallback,
+                                         int capacity,
+                                         const std::vector<int> &roleTypes,
+                                         const std::vector<QByteArray> &roleNames)
+    : DosQAbstractListModel(modelObject, std::move(metaObject), dObjectCallback)
+    , m_capacity(capacity)
+    , m_rows(createColumns(roleTypes))
+    , m_staging(createColumns(roleTypes))
+    , m_publishing(createColumns(roleTypes))
+{
+    // The ring is allocated once for the whole capacity
+    for (auto &column : m_rows)
+        column->insert(0, nullptr, m_capacity);
+    for (size_t i = 0; i < roleNames.size(); ++i)
+        m_roleNames.insert(Qt::UserRole + 1 + static_cast<int>(i), roleNames[i]);
+}
+
+int DosQRingBufferModel::capacity() const
+{
+    return m_capacity;
+}
+
+void DosQRingBufferModel::append(int count, const void **columns)
+{
+    if (count <= 0)
+        return;
+
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(m_stagingMutex);
+        for (size_t i = 0; i < m_staging.size(); ++i)
+            m_staging[i]->insert(m_stagedCount, columns ? columns[i] : nullptr, count);
+        m_stagedCount += count;
+
+        // Rows that would be evicted on publish are dropped right away to bound the memory
+        if (m_stagedCount > m_capacity) {
+            for (auto &column : m_staging)
+                column->remove(0, m_stagedCount - m_capacity);
+            m_stagedCount = m_capacity;
+        }
+
+        schedule = !m_publishScheduled;
+        m_publishScheduled = true;
+    }
+
+    if (schedule) {
+        QMetaObject::invokeMethod(this, [this] {
+            QTimer::singleShot(PublishInterval, this, [this] { publish(); });
+        }, Qt::QueuedConnection);
+    }
+}
+
+void DosQRingBufferModel::publish()
+{
+    int count = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_stagingMutex);
+        m_staging.swap(m_publishing);
+        count = m_stagedCount;
+        m_stagedCount = 0;
+        m_publishScheduled = false;
+    }
+
+    if (count == 0)
+        return;
+
+    if (count >= m_capacity) {
+        // Every row is replaced
+        publicBeginResetModel();
+        m_head = 0;
+        writeRows(0, count - m_capacity, m_capacity);
+        m_rowCount = m_capacity;
+        publicEndResetModel();
+    } else {
+        const int evicted = m_rowCount + count - m_capacity;
+        if (evicted > 0) {
+            publicBeginRemoveRows(QModelIndex(), 0, evicted - 1);
+            m_head = position(evicted);
+            m_rowCount -= evicted;
+            publicEndRemoveRows();
+        }
+
+        publicBeginInsertRows(QModelIndex(), m_rowCount, m_rowCount + count - 1);
+        writeRows(m_rowCount, 0, count);
+        m_rowCount += count;
+        publicEndInsertRows();
+    }
+
+    for (auto &column : m_publishing)
+        column->remove(0, count);
+}
+
+void DosQRingBufferModel::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_stagingMutex);
+        for (auto &column : m_staging)
+            column->remove(0, m_stagedCount);
+        m_stagedCount = 0;
+    }
+
+    publicBeginResetModel();
+    m_head = 0;
+    m_rowCount = 0;
+    publicEndResetModel();
+}
+
+int DosQRingBufferModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int DosQRingBufferModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QVariant DosQRingBufferModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount || index.column() != 0)
+        return QVariant();
+    // The display role is an alias of the first role
+    const int column = role == Qt::DisplayRole ? 0 : role - Qt::UserRole - 1;
+    if (column < 0 || column >= static_cast<int>(m_rows.size()))
+        return QVariant();
+    return m_rows[column]->value(position(index.row()));
+}
+
+bool DosQRingBufferModel::setData(const QModelIndex &, const QVariant &, int)
+{
+    return false;
+}
+
+Qt::ItemFlags DosQRingBufferModel::flags(const QModelIndex &index) const
+{
+    return QAbstractListModel::flags(index);
+}
+
+QVariant DosQRingBufferModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    return QAbstractListModel::headerData(section, orientation, role);
+}
+
+QModelIndex DosQRingBufferModel::index(int row, int column, const QModelIndex &parent) const
+{
+    return QAbstractListModel::index(row, column, parent);
+}
+
+QModelIndex DosQRingBufferModel::parent(const QModelIndex &) const
+{
+    return QModelIndex();
+}
+
+QHash<int, QByteArray> DosQRingBufferModel::roleNames() const
+{
+    return m_roleNames;
+}
+
+bool DosQRingBufferModel::hasChildren(const QModelIndex &parent) const
+{
+    return parent.isValid() ? false : m_rowCount > 0;
+}
+
+bool DosQRingBufferModel::canFetchMore(const QModelIndex &) const
+{
+    return false;
+}
+
+void DosQRingBufferModel::fetchMore(const QModelIndex &)
+{
+}
+
+DosQRingBufferModel::Columns DosQRingBufferModel::createColumns(const std::vector<int> &roleTypes)
+{
+    Columns result;
+    for (int roleType : roleTypes)
+        result.push_back(DosQColumnBuffer::create(roleType));
+    return result;
+}
+
+void DosQRingBufferModel::writeRows(int row, int sourceRow, int count)
+{
+    // The rows wrap around the end of the ring at most once
+    const int first = position(row);
+    const int firstCount = std::min(count, m_capacity - first);
+    for (size_t i = 0; i < m_rows.size(); ++i) {
+        m_rows[i]->copy(first, *m_publishing[i], sourceRow, firstCount);
+        if (count > firstCount)
+            m_rows[i]->copy(0, *m_publishing[i], sourceRow + firstCount, count - firstCount);
+    }
+}
+
+int DosQRingBufferModel::position(int row) const
+{
+    return (m_head + row) % m_capacity;
+}
+
+} // namespace DOS
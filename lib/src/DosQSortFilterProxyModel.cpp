@@ -0,0 +1,511 @@
+/*
+    Copyright (C) 2020 Filippo Cucchetto.
+    Contact: https://github.com/filcuc/dotherside
+
+    This file is part of the DOtherSide library.
+
+    The DOtherSide library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the license, or (at your opinion) any later version.
+
+    The DOtherSide library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with the DOtherSide library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "DOtherSide/DosQSortFilterProxyModel.h"
+
+// std
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <numeric>
+
+// Qt
+#include <QtCore/QThread>
+
+namespace {
+
+/// Below this number of rows snapshots are processed on the calling thread
+const int ParallelThreshold = 65536;
+
+int chunkCount(int count)
+{
+    return count < ParallelThreshold ? 1 : std::max(1, QThread::idealThreadCount());
+}
+
+/// Call function(first, last) on consecutive chunks of [0, count) in parallel
+template<typename Function>
+void parallelFor(int count, const Function &function)
+{
+    const int chunks = chunkCount(count);
+    const int chunkSize = (count + chunks - 1) / chunks;
+    std::vector<std::future<void>> futures;
+    for (int first = chunkSize; first < count; first += chunkSize)
+        futures.push_back(std::async(std::launch::async, function, first, std::min(count, first + chunkSize)));
+    function(0, std::min(count, chunkSize));
+    for (auto &future : futures)
+        future.get();
+}
+
+/// Sort chunks of rows in parallel and merge them pairwise
+template<typename Less>
+void parallelSort(std::vector<int> &rows, const Less &less)
+{
+    const int count = static_cast<int>(rows.size());
+    const int chunks = chunkCount(count);
+    if (chunks == 1) {
+        std::sort(rows.begin(), rows.end(), less);
+        return;
+    }
+
+    const int chunkSize = (count + chunks - 1) / chunks;
+    std::vector<int> bounds;
+    for (int first = 0; first < count; first += chunkSize)
+        bounds.push_back(first);
+    bounds.push_back(count);
+
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        auto first = rows.begin() + bounds[i];
+        auto last = rows.begin() + bounds[i + 1];
+        futures.push_back(std::async(std::launch::async, [first, last, &less] { std::sort(first, last, less); }));
+    }
+    for (auto &future : futures)
+        future.get();
+
+    while (bounds.size() > 2) {
+        futures.clear();
+        std::vector<int> merged { bounds[0] };
+        for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            auto first = rows.begin() + bounds[i];
+            auto middle = rows.begin() + bounds[i + 1];
+            auto last = rows.begin() + bounds[i + 2];
+            futures.push_back(std::async(std::launch::async, [first, middle, last, &less] { std::inplace_merge(first, middle, last, less); }));
+            merged.push_back(bounds[i + 2]);
+        }
+        if (bounds.size() % 2 == 0)
+            merged.push_back(bounds.back());
+        for (auto &future : futures)
+            future.get();
+        bounds.swap(merged);
+    }
+}
+
+bool isNumber(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isFlatModelType(const QAbstractItemModel *model)
+{
+    return model->inherits("QAbstractListModel") || model->inherits("QAbstractTableModel");
+}
+
+}
+
+namespace DOS {
+
+DosQSortFilterProxyModel::DosQSortFilterProxyModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{}
+
+void DosQSortFilterProxyModel::setSourceModel(QAbstractItemModel *source)
+{
+    for (const auto &connection : m_sourceConnections)
+        disconnect(connection);
+    m_sourceConnections.clear();
+    m_sortKeys = Keys();
+    m_filterKeys = Keys();
+    m_ranks.clear();
+    m_ranksValid = false;
+    m_accepted.clear();
+
+    if (source) {
+        // Connected before QSortFilterProxyModel so that the snapshots are updated
+        // by the time the proxy reacts to the same signals
+        m_sourceConnections.push_back(connect(source, &QAbstractItemModel::rowsInserted, this, &DosQSortFilterProxyModel::onSourceRowsInserted));
+        m_sourceConnections.push_back(connect(source, &QAbstractItemModel::rowsRemoved, this, &DosQSortFilterProxyModel::onSourceRowsRemoved));
+        m_sourceConnections.push_back(connect(source, &QAbstractItemModel::dataChanged, this, &DosQSortFilterProxyModel::onSourceDataChanged));
+        m_sourceConnections.push_back(connect(source, &QAbstractItemModel::rowsMoved, this, &DosQSortFilterProxyModel::onSourceLayoutChanged));
+        m_sourceConnections.push_back(connect(source, &QAbstractItemModel::layoutChanged, this, &DosQSortFilterProxyModel::onSourceLayoutChanged));
+        m_sourceConnections.push_back(connect(source, &QAbstractItemModel::modelReset, this, &DosQSortFilterProxyModel::onSourceLayoutChanged));
+    }
+
+    QSortFilterProxyModel::setSourceModel(source);
+    onSourceLayoutChanged();
+    if (!m_filterString.isNull())
+        invalidateFilter();
+}
+
+void DosQSortFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+    if (column >= 0 && (!m_sortKeys.valid || m_sortKeys.column != column || m_sortKeys.role != sortRole()))
+        refreshSortKeys(sortRole(), column);
+    else if (column >= 0 && !hasValidRanks())
+        rankSortKeys();
+    QSortFilterProxyModel::sort(column, order);
+}
+
+void DosQSortFilterProxyModel::setFilterString(const QString &filter)
+{
+    if (filter.isNull()) {
+        m_filterString = QString();
+        m_filterKeys = Keys();
+        m_accepted.clear();
+        invalidateFilter();
+        return;
+    }
+
+    const Qt::CaseSensitivity caseSensitivity = filterCaseSensitivity();
+    const bool incremental = !m_filterString.isNull()
+                             && m_filterCaseSensitivity == caseSensitivity
+                             && filter.contains(m_filterString, caseSensitivity);
+    m_filterString = filter;
+
+    if (!m_filterKeys.valid || m_filterKeys.role != filterRole() || m_filterKeys.column != filterKeyColumn())
+        refreshFilterKeys(filterRole(), filterKeyColumn());
+    else
+        refilter(incremental);
+    invalidateFilter();
+}
+
+bool DosQSortFilterProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
+{
+    const int left = sourceLeft.row();
+    const int right = sourceRight.row();
+    const int count = m_sortKeys.size();
+    if (!m_flatSource || !m_sortKeys.valid || sourceLeft.column() != m_sortKeys.column
+            || sortRole() != m_sortKeys.role || left >= count || right >= count) {
+        if (m_flatSource && isSortKeysOutdated())
+            scheduleRefresh();
+        return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+    }
+
+    if (hasValidRanks())
+        return m_ranks[left] < m_ranks[right];
+    return compareSortKeys(left, right, sortCaseSensitivity(), isSortLocaleAware()) < 0;
+}
+
+bool DosQSortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (m_filterString.isNull())
+        return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+
+    if (sourceParent.isValid() || !m_filterKeys.valid
+            || filterRole() != m_filterKeys.role || filterKeyColumn() != m_filterKeys.column
+            || sourceRow >= static_cast<int>(m_filterKeys.strings.size())) {
+        if (!sourceParent.isValid() && isFilterKeysOutdated())
+            scheduleRefresh();
+        return sourceMatchesFilterString(sourceRow, sourceParent);
+    }
+
+    const Qt::CaseSensitivity caseSensitivity = filterCaseSensitivity();
+    if (caseSensitivity == m_filterCaseSensitivity)
+        return m_accepted[sourceRow] != 0;
+    return matchesFilterString(sourceRow, caseSensitivity);
+}
+
+bool DosQSortFilterProxyModel::storeKey(Keys &keys, int row, const QVariant &value)
+{
+    if (!keys.numeric) {
+        keys.strings[row] = value.toString();
+        return true;
+    }
+    if (!value.isValid()) {
+        keys.numbers[row] = std::numeric_limits<double>::lowest();
+        return true;
+    }
+    if (!isNumber(value))
+        return false;
+    keys.numbers[row] = value.toDouble();
+    return true;
+}
+
+DosQSortFilterProxyModel::Keys DosQSortFilterProxyModel::createKeys(int role, int column, bool allowNumbers) const
+{
+    Keys keys;
+    keys.role = role;
+    keys.column = column;
+
+    const QAbstractItemModel *source = sourceModel();
+    if (!source || column < 0 || column >= source->columnCount())
+        return keys;
+
+    // The source model must be read from its own thread, the conversion is parallel
+    const int count = source->rowCount();
+    std::vector<QVariant> values;
+    values.reserve(count);
+    for (int row = 0; row < count; ++row) {
+        values.push_back(source->data(source->index(row, column), role));
+        keys.numeric = keys.numeric && allowNumbers && (isNumber(values.back()) || !values.back().isValid());
+    }
+
+    if (keys.numeric)
+        keys.numbers.resize(count);
+    else
+        keys.strings.resize(count);
+    parallelFor(count, [&keys, &values](int first, int last) {
+        for (int row = first; row < last; ++row)
+            storeKey(keys, row, values[row]);
+    });
+    keys.valid = true;
+    return keys;
+}
+
+int DosQSortFilterProxyModel::compareSortKeys(int left, int right, Qt::CaseSensitivity caseSensitivity, bool localeAware) const
+{
+    if (m_sortKeys.numeric) {
+        const double lhs = m_sortKeys.numbers[left];
+        const double rhs = m_sortKeys.numbers[right];
+        return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+    }
+    const QString &lhs = m_sortKeys.strings[left];
+    const QString &rhs = m_sortKeys.strings[right];
+    return localeAware ? QString::localeAwareCompare(lhs, rhs) : QString::compare(lhs, rhs, caseSensitivity);
+}
+
+bool DosQSortFilterProxyModel::hasValidRanks() const
+{
+    return m_ranksValid && m_ranksCaseSensitivity == sortCaseSensitivity() && m_ranksLocaleAware == isSortLocaleAware();
+}
+
+bool DosQSortFilterProxyModel::matchesFilterString(int row, Qt::CaseSensitivity caseSensitivity) const
+{
+    return m_filterKeys.strings[row].contains(m_filterString, caseSensitivity);
+}
+
+bool DosQSortFilterProxyModel::sourceMatchesFilterString(int sourceRow, const QModelIndex &sourceParent) const
+{
+    const QAbstractItemModel *source = sourceModel();
+    const Qt::CaseSensitivity caseSensitivity = filterCaseSensitivity();
+    const int column = filterKeyColumn();
+    if (column >= 0)
+        return source->data(source->index(sourceRow, column, sourceParent), filterRole()).toString().contains(m_filterString, caseSensitivity);
+
+    // Like QSortFilterProxyModel a negative filter column matches any column
+    const int columns = source->columnCount(sourceParent);
+    for (int i = 0; i < columns; ++i) {
+        if (source->data(source->index(sourceRow, i, sourceParent), filterRole()).toString().contains(m_filterString, caseSensitivity))
+            return true;
+    }
+    return false;
+}
+
+bool DosQSortFilterProxyModel::isSortKeysOutdated() const
+{
+    return sortColumn() >= 0 && (m_sortKeys.role != sortRole() || m_sortKeys.column != sortColumn());
+}
+
+bool DosQSortFilterProxyModel::isFilterKeysOutdated() const
+{
+    return !m_filterString.isNull() && (m_filterKeys.role != filterRole() || m_filterKeys.column != filterKeyColumn());
+}
+
+void DosQSortFilterProxyModel::scheduleRefresh() const
+{
+    if (m_refreshScheduled)
+        return;
+    m_refreshScheduled = true;
+    auto self = const_cast<DosQSortFilterProxyModel *>(this);
+    QMetaObject::invokeMethod(self, [self] { self->refreshOutdatedKeys(); }, Qt::QueuedConnection);
+}
+
+void DosQSortFilterProxyModel::refreshOutdatedKeys()
+{
+    // The proxy already sorted and filtered through the source model thus only the snapshots change
+    m_refreshScheduled = false;
+    if (isSortKeysOutdated())
+        refreshSortKeys(sortRole(), sortColumn());
+    if (isFilterKeysOutdated())
+        refreshFilterKeys(filterRole(), filterKeyColumn());
+}
+
+void DosQSortFilterProxyModel::refreshSortKeys(int role, int column)
+{
+    m_sortKeys = createKeys(role, column, true);
+    rankSortKeys();
+}
+
+void DosQSortFilterProxyModel::rankSortKeys()
+{
+    m_ranksValid = false;
+    if (!m_sortKeys.valid)
+        return;
+
+    // Ties are broken by source row so the ranks order matches a stable sort
+    const Qt::CaseSensitivity caseSensitivity = sortCaseSensitivity();
+    const bool localeAware = isSortLocaleAware();
+    const int count = m_sortKeys.size();
+    std::vector<int> rows(count);
+    std::iota(rows.begin(), rows.end(), 0);
+    parallelSort(rows, [this, caseSensitivity, localeAware](int left, int right) {
+        const int result = compareSortKeys(left, right, caseSensitivity, localeAware);
+        return result < 0 || (result == 0 && left < right);
+    });
+
+    m_ranks.resize(count);
+    for (int rank = 0; rank < count; ++rank)
+        m_ranks[rows[rank]] = rank;
+    m_ranksCaseSensitivity = caseSensitivity;
+    m_ranksLocaleAware = localeAware;
+    m_ranksValid = true;
+}
+
+void DosQSortFilterProxyModel::refreshFilterKeys(int role, int column)
+{
+    m_filterKeys = createKeys(role, column, false);
+    refilter(false);
+}
+
+void DosQSortFilterProxyModel::refilter(bool incremental)
+{
+    const int count = static_cast<int>(m_filterKeys.strings.size());
+    const Qt::CaseSensitivity caseSensitivity = filterCaseSensitivity();
+    m_filterCaseSensitivity = caseSensitivity;
+    if (!incremental || static_cast<int>(m_accepted.size()) != count)
+        m_accepted.assign(count, 1);
+    if (m_filterString.isEmpty())
+        return;
+
+    // Rows rejected by a substring of the new filter are rejected by the new filter too
+    parallelFor(count, [this, caseSensitivity](int first, int last) {
+        for (int row = first; row < last; ++row)
+            if (m_accepted[row])
+                m_accepted[row] = matchesFilterString(row, caseSensitivity) ? 1 : 0;
+    });
+}
+
+void DosQSortFilterProxyModel::onSourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        m_flatSource = false;
+        return;
+    }
+
+    const QAbstractItemModel *source = sourceModel();
+    const int count = last - first + 1;
+
+    if (m_sortKeys.valid) {
+        if (m_sortKeys.numeric)
+            m_sortKeys.numbers.insert(m_sortKeys.numbers.begin() + first, count, 0.0);
+        else
+            m_sortKeys.strings.insert(m_sortKeys.strings.begin() + first, count, QString());
+        for (int row = first; row <= last; ++row) {
+            if (!storeKey(m_sortKeys, row, source->data(source->index(row, m_sortKeys.column), m_sortKeys.role))) {
+                m_sortKeys = createKeys(m_sortKeys.role, m_sortKeys.column, true);
+                break;
+            }
+        }
+        m_ranksValid = false;
+    }
+
+    if (m_filterKeys.valid) {
+        m_filterKeys.strings.insert(m_filterKeys.strings.begin() + first, count, QString());
+        m_accepted.insert(m_accepted.begin() + first, count, 1);
+        for (int row = first; row <= last; ++row) {
+            storeKey(m_filterKeys, row, source->data(source->index(row, m_filterKeys.column), m_filterKeys.role));
+            if (!m_filterString.isEmpty())
+                m_accepted[row] = matchesFilterString(row, m_filterCaseSensitivity) ? 1 : 0;
+        }
+    }
+
+    if (isFlatModelType(source))
+        return;
+    for (int row = first; m_flatSource && row <= last; ++row)
+        m_flatSource = !source->hasChildren(source->index(row, 0));
+}
+
+void DosQSortFilterProxyModel::onSourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    // Removing rows preserves the relative order of the remaining ranks
+    if (m_sortKeys.valid) {
+        if (m_sortKeys.numeric)
+            m_sortKeys.numbers.erase(m_sortKeys.numbers.begin() + first, m_sortKeys.numbers.begin() + last + 1);
+        else
+            m_sortKeys.strings.erase(m_sortKeys.strings.begin() + first, m_sortKeys.strings.begin() + last + 1);
+        if (m_ranksValid)
+            m_ranks.erase(m_ranks.begin() + first, m_ranks.begin() + last + 1);
+    }
+
+    if (m_filterKeys.valid) {
+        m_filterKeys.strings.erase(m_filterKeys.strings.begin() + first, m_filterKeys.strings.begin() + last + 1);
+        m_accepted.erase(m_accepted.begin() + first, m_accepted.begin() + last + 1);
+    }
+}
+
+void DosQSortFilterProxyModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    if (!topLeft.isValid() || topLeft.parent().isValid())
+        return;
+
+    const QAbstractItemModel *source = sourceModel();
+    auto isAffected = [&](const Keys &keys) {
+        return keys.valid && keys.column >= topLeft.column() && keys.column <= bottomRight.column()
+               && (roles.isEmpty() || roles.contains(keys.role));
+    };
+
+    if (isAffected(m_sortKeys)) {
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+            if (!storeKey(m_sortKeys, row, source->data(source->index(row, m_sortKeys.column), m_sortKeys.role))) {
+                m_sortKeys = createKeys(m_sortKeys.role, m_sortKeys.column, true);
+                break;
+            }
+        }
+        m_ranksValid = false;
+    }
+
+    if (isAffected(m_filterKeys)) {
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+            storeKey(m_filterKeys, row, source->data(source->index(row, m_filterKeys.column), m_filterKeys.role));
+            m_accepted[row] = (m_filterString.isEmpty() || matchesFilterString(row, m_filterCaseSensitivity)) ? 1 : 0;
+        }
+    }
+}
+
+void DosQSortFilterProxyModel::onSourceLayoutChanged()
+{
+    m_flatSource = isSourceFlat();
+    if (sortColumn() >= 0)
+        refreshSortKeys(sortRole(), sortColumn());
+    else
+        m_sortKeys = Keys();
+    if (!m_filterString.isNull())
+        refreshFilterKeys(filterRole(), filterKeyColumn());
+}
+
+bool DosQSortFilterProxyModel::isSourceFlat() const
+{
+    const QAbstractItemModel *source = sourceModel();
+    if (!source)
+        return false;
+    if (isFlatModelType(source))
+        return true;
+    const int count = source->rowCount();
+    for (int row = 0; row < count; ++row)
+        if (source->hasChildren(source->index(row, 0)))
+            return false;
+    return true;
+}
+
+} // namespace DOS
@@ -70,11 +70,14 @@ VoidPointer initializeMetaObject()
 }
 }
 
-MockQAbstractItemModel::MockQAbstractItemModel()
+MockQAbstractItemModel::MockQAbstractItemModel(int options)
     : m_vptr(nullptr, &dos_qobject_delete)
     , m_names({"John", "Mary", "Andy", "Anna"})
+    , m_dataCalls(0)
+    , m_fetchRangeCalls(0)
+    , m_headerDataCalls(0)
 {
-    DosQAbstractItemModelCallbacks callbacks;
+    DosQAbstractItemModelCallbacks callbacks = {};
     callbacks.rowCount = &onRowCountCalled;
     callbacks.columnCount = &onColumnCountCalled;
     callbacks.data = &onDataCalled;
@@ -84,8 +87,19 @@ MockQAbstractItemModel::MockQAbstractItemModel()
     callbacks.headerData = &onHeaderDataCalled;
     callbacks.index = &onIndexCalled;
     callbacks.parent = &onParentCalled;
+    if (options & AsyncFetch) {
+        callbacks.canFetchMore = &onCanFetchMoreCalled;
+        callbacks.fetchMore = &onFetchMoreCalled;
+    }
 
-    m_vptr.reset(dos_qabstractitemmodel_create(this, metaObject(), &onSlotCalled, &callbacks));
+    if (options & ListModel)
+        m_vptr.reset(dos_qabstractlistmodel_create(this, metaObject(), &onSlotCalled, &callbacks));
+    else
+        m_vptr.reset(dos_qabstractitemmodel_create(this, metaObject(), &onSlotCalled, &callbacks));
+    if (options & FetchRange)
+        dos_qabstractitemmodel_setFetchRangeCallback(m_vptr.get(), &onFetchRangeCalled);
+    if (options & AsyncFetch)
+        dos_qabstractitemmodel_setCommitFetchedRowsCallback(m_vptr.get(), &onCommitFetchedRowsCalled);
 }
 
 DosQMetaObject *MockQAbstractItemModel::metaObject()
@@ -132,6 +146,31 @@ void MockQAbstractItemModel::nameChanged(const string &name)
     dos_qvariant_delete(argv[0]);
 }
 
+void MockQAbstractItemModel::setNames(std::vector<std::string> names)
+{
+    m_names = std::move(names);
+}
+
+void MockQAbstractItemModel::setFetchableNames(std::vector<std::string> names)
+{
+    m_fetchableNames = std::move(names);
+}
+
+int MockQAbstractItemModel::dataCalls() const
+{
+    return m_dataCalls;
+}
+
+int MockQAbstractItemModel::fetchRangeCalls() const
+{
+    return m_fetchRangeCalls;
+}
+
+int MockQAbstractItemModel::headerDataCalls() const
+{
+    return m_headerDataCalls;
+}
+
 void MockQAbstractItemModel::onSlotCalled(void *selfVPtr, DosQVariant *dosSlotNameVariant, int /*dosSlotArgc*/, DosQVariant **dosSlotArgv)
 {
     auto self = static_cast<MockQAbstractItemModel *>(selfVPtr);
@@ -165,6 +204,7 @@ void MockQAbstractItemModel::onColumnCountCalled(void *selfVPtr, const DosQModel
 void MockQAbstractItemModel::onDataCalled(void *selfVPtr, const DosQModelIndex *index, int /*role*/, DosQVariant *result)
 {
     auto self = static_cast<MockQAbstractItemModel *>(selfVPtr);
+    ++self->m_dataCalls;
 
     if (!dos_qmodelindex_isValid(index))
         return;
@@ -178,6 +218,39 @@ void MockQAbstractItemModel::onDataCalled(void *selfVPtr, const DosQModelIndex *
     dos_qvariant_setString(result, self->m_names[row].c_str());
 }
 
+void MockQAbstractItemModel::onFetchRangeCalled(void *selfVPtr, const DosQModelIndex */*parent*/, int column, int firstRow, int lastRow,
+                                                const int */*roles*/, int rolesCount, DosQVariant **result)
+{
+    auto self = static_cast<MockQAbstractItemModel *>(selfVPtr);
+    ++self->m_fetchRangeCalls;
+
+    if (column != 0)
+        return;
+
+    for (int row = firstRow; row <= lastRow; ++row)
+        for (int i = 0; i < rolesCount; ++i)
+            dos_qvariant_setString(result[(row - firstRow) * rolesCount + i], self->m_names[row].c_str());
+}
+
+void MockQAbstractItemModel::onCanFetchMoreCalled(void *selfVPtr, const DosQModelIndex */*parent*/, bool *result)
+{
+    auto self = static_cast<MockQAbstractItemModel *>(selfVPtr);
+    *result = !self->m_fetchableNames.empty();
+}
+
+void MockQAbstractItemModel::onFetchMoreCalled(void */*selfVPtr*/, const DosQModelIndex */*parent*/)
+{
+    // Loading is simulated by the test calling dos_qabstractitemmodel_fetchComplete
+}
+
+void MockQAbstractItemModel::onCommitFetchedRowsCalled(void *selfVPtr, const DosQModelIndex */*parent*/, int count)
+{
+    auto self = static_cast<MockQAbstractItemModel *>(selfVPtr);
+    auto last = self->m_fetchableNames.begin() + count;
+    self->m_names.insert(self->m_names.end(), self->m_fetchableNames.begin(), last);
+    self->m_fetchableNames.erase(self->m_fetchableNames.begin(), last);
+}
+
 void MockQAbstractItemModel::onSetDataCalled(void *selfVPtr, const DosQModelIndex *index, const DosQVariant *value, int /*role*/, bool *result)
 {
     auto self = static_cast<MockQAbstractItemModel *>(selfVPtr);
@@ -208,9 +281,11 @@ void MockQAbstractItemModel::onFlagsCalled(void */*selfVPtr*/, const DosQModelIn
 
 }
 
-void MockQAbstractItemModel::onHeaderDataCalled(void */*selfVPtr*/, int /*section*/, int /*orientation*/, int /*role*/, DosQVariant */*result*/)
+void MockQAbstractItemModel::onHeaderDataCalled(void *selfVPtr, int section, int /*orientation*/, int /*role*/, DosQVariant *result)
 {
-
+    auto self = static_cast<MockQAbstractItemModel *>(selfVPtr);
+    ++self->m_headerDataCalls;
+    dos_qvariant_setInt(result, section);
 }
 
 void MockQAbstractItemModel::onIndexCalled(void *selfVPtr, int row, int column, const DosQModelIndex */*parent*/, DosQModelIndex *result)
@@ -7,7 +7,14 @@
 class MockQAbstractItemModel
 {
 public:
-    MockQAbstractItemModel();
+    enum Option {
+        NoOption = 0,
+        FetchRange = 1,
+        AsyncFetch = 2,
+        ListModel = 4
+    };
+
+    explicit MockQAbstractItemModel(int options = NoOption);
 
     DosQMetaObject *metaObject();
     DosQObject *data();
@@ -19,6 +26,13 @@ public:
     void setName(const std::string &name);
     void nameChanged(const std::string &name);
 
+    void setNames(std::vector<std::string> names);
+    void setFetchableNames(std::vector<std::string> names);
+
+    int dataCalls() const;
+    int fetchRangeCalls() const;
+    int headerDataCalls() const;
+
 private:
     static void onSlotCalled(void *selfVPtr, DosQVariant *dosSlotNameVariant, int dosSlotArgc, DosQVariant **dosSlotArgv);
     static void onRowCountCalled(void *selfVPtr, const DosQModelIndex *index, int *result);
@@ -30,8 +44,17 @@ private:
     static void onHeaderDataCalled(void *selfVPtr, int section, int orientation, int role, DosQVariant *result);
     static void onIndexCalled(void *selfVPtr, int row, int column, const DosQModelIndex *parent, DosQModelIndex *result);
     static void onParentCalled(void *selfVPtr, const DosQModelIndex *child, DosQModelIndex *result);
+    static void onFetchRangeCalled(void *selfVPtr, const DosQModelIndex *parent, int column, int firstRow, int lastRow,
+                                   const int *roles, int rolesCount, DosQVariant **result);
+    static void onCanFetchMoreCalled(void *selfVPtr, const DosQModelIndex *parent, bool *result);
+    static void onFetchMoreCalled(void *selfVPtr, const DosQModelIndex *parent);
+    static void onCommitFetchedRowsCalled(void *selfVPtr, const DosQModelIndex *parent, int count);
 
     VoidPointer m_vptr;
     std::string m_name;
     std::vector<std::string> m_names;
+    std::vector<std::string> m_fetchableNames;
+    int m_dataCalls;
+    int m_fetchRangeCalls;
+    int m_headerDataCalls;
 };
@@ -0,0 +1,6 @@
+import QtQuick 2.12
+
+Item {
+    objectName: "testComponent"
+    property int value: 42
+}
@@ -1,4 +1,6 @@
 // std
+#include <atomic>
+#include <cstddef>
 #include <tuple>
 #include <iostream>
 #include <memory>
@@ -6,12 +8,17 @@
 #include <QDebug>
 #include <QTest>
 #include <QSignalSpy>
+#include <QSortFilterProxyModel>
 #include <QTimer>
+#include <QThread>
+#include <QTemporaryDir>
+#include <QtEndian>
 #include <QApplication>
 #include <QQuickWindow>
 #include <QQmlApplicationEngine>
 #include <QQuickItem>
 #include <QQmlContext>
+#include <QQmlComponent>
 #include <QtQuickTest/QtQuickTest>
 
 // DOtherSide
@@ -296,6 +303,31 @@ private slots:
         QVERIFY(engine()->rootObjects().front()->isWindowType());
     }
 
+    void testPreload()
+    {
+        VoidPointer component(dos_qurl_create("qrc:///testQQmlComponent.qml", QUrl::TolerantMode), &dos_qurl_delete);
+        VoidPointer view(dos_qurl_create("qrc:///testQQuickView.qml", QUrl::TolerantMode), &dos_qurl_delete);
+        VoidPointer missing(dos_qurl_create("qrc:///missing.qml", QUrl::TolerantMode), &dos_qurl_delete);
+        DosQUrl *urls[] = { component.get(), view.get(), missing.get() };
+
+        std::vector<int> statuses;
+        auto onCompiled = [](void *data, int index, int status, double milliseconds) {
+            auto statuses = static_cast<std::vector<int> *>(data);
+            QCOMPARE(index, int(statuses->size()));
+            QVERIFY(milliseconds >= 0);
+            statuses->push_back(status);
+        };
+        dos_qqmlapplicationengine_preload(m_engine, urls, 3, onCompiled, &statuses);
+        QTRY_COMPARE(statuses.size(), size_t(3));
+        QCOMPARE(statuses[0], int(DosQQmlComponentStatusReady));
+        QCOMPARE(statuses[1], int(DosQQmlComponentStatusReady));
+        QCOMPARE(statuses[2], int(DosQQmlComponentStatusError));
+
+        // Preloaded files are ready as soon as they're requested
+        QQmlComponent cached(engine(), QUrl("qrc:///testQQmlComponent.qml"), QQmlComponent::Asynchronous);
+        QCOMPARE(cached.status(), QQmlComponent::Ready);
+    }
+
 private:
     QQmlApplicationEngine *engine()
     {
@@ -356,6 +388,19 @@ private slots:
         QCOMPARE(label->property("text").toString(), testData.toString());
     }
 
+    void testSetContextProperties()
+    {
+        QVariant first("Test");
+        QVariant second(" Message");
+        const char *names[] = { "first", "second" };
+        DosQVariant *values[] = { &first, &second };
+        dos_qqmlcontext_setcontextproperties(m_context, 2, names, values);
+        engine()->loadData("import QtQuick 2.12; Text { objectName: \"label\"; text: first + second } ");
+        QObject *label = engine()->rootObjects().first();
+        QVERIFY(label != nullptr);
+        QCOMPARE(label->property("text").toString(), QString::fromLocal8Bit("Test Message"));
+    }
+
 private:
     QQmlApplicationEngine *engine()
     {
@@ -370,6 +415,134 @@ private:
     void *m_context;
 };
 
+/*
+ * Test QQmlComponent
+ */
+class TestQQmlComponent : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init()
+    {
+        m_engine = dos_qqmlapplicationengine_create();
+        QVERIFY(m_engine != nullptr);
+    }
+
+    void cleanup()
+    {
+        dos_qqmlapplicationengine_delete(m_engine);
+        m_engine = nullptr;
+    }
+
+    void testLoadUrlAsynchronous()
+    {
+        std::vector<int> statuses;
+        auto onStatusChanged = [](void *data, int status) {
+            static_cast<std::vector<int> *>(data)->push_back(status);
+        };
+        VoidPointer component(dos_qqmlcomponent_create(m_engine, onStatusChanged, &statuses), &dos_qqmlcomponent_delete);
+        VoidPointer url(dos_qurl_create("qrc:///testQQmlComponent.qml", QUrl::TolerantMode), &dos_qurl_delete);
+        dos_qqmlcomponent_load_url(component.get(), url.get(), true);
+        QTRY_COMPARE(dos_qqmlcomponent_status(component.get()), int(DosQQmlComponentStatusReady));
+        QVERIFY(!statuses.empty());
+        QCOMPARE(statuses.back(), int(DosQQmlComponentStatusReady));
+
+        VoidPointer object(dos_qqmlcomponent_create_object(component.get(), nullptr), &dos_qobject_delete);
+        QVERIFY(object);
+        QCOMPARE(static_cast<QObject *>(object.get())->objectName(), QString::fromLocal8Bit("testComponent"));
+    }
+
+    void testLoadError()
+    {
+        VoidPointer component(dos_qqmlcomponent_create(m_engine, nullptr, nullptr), &dos_qqmlcomponent_delete);
+        VoidPointer url(dos_qurl_create("qrc:///", QUrl::TolerantMode), &dos_qurl_delete);
+        dos_qqmlcomponent_set_data(component.get(), "import QtQuick 2.12; Item { unknownProperty: 1 }", url.get());
+        QCOMPARE(dos_qqmlcomponent_status(component.get()), int(DosQQmlComponentStatusError));
+        CharPointer error(dos_qqmlcomponent_error_string(component.get()), &dos_chararray_delete);
+        QVERIFY(QByteArray(error.get()).contains("unknownProperty"));
+        QVERIFY(!dos_qqmlcomponent_create_object(component.get(), nullptr));
+    }
+
+    void testIncubate()
+    {
+        dos_qqmlapplicationengine_set_incubation_budget(m_engine, 4);
+        VoidPointer component(dos_qqmlcomponent_create(m_engine, nullptr, nullptr), &dos_qqmlcomponent_delete);
+        VoidPointer url(dos_qurl_create("qrc:///testQQmlComponent.qml", QUrl::TolerantMode), &dos_qurl_delete);
+        dos_qqmlcomponent_load_url(component.get(), url.get(), false);
+        QCOMPARE(dos_qqmlcomponent_status(component.get()), int(DosQQmlComponentStatusReady));
+
+        auto onCompleted = [](void *data, DosQObject *object) {
+            *static_cast<QObject **>(data) = static_cast<QObject *>(object);
+        };
+
+        QObject *first = nullptr;
+        VoidPointer incubator(dos_qqmlcomponent_incubate(component.get(), nullptr, onCompleted, &first), &dos_qqmlincubator_delete);
+        QTRY_VERIFY(first != nullptr);
+        QCOMPARE(dos_qqmlincubator_status(incubator.get()), int(DosQQmlIncubatorStatusReady));
+        QCOMPARE(first->property("value").toInt(), 42);
+        incubator.reset();
+        dos_qobject_delete(first);
+
+        QObject *second = nullptr;
+        incubator.reset(dos_qqmlcomponent_incubate(component.get(), nullptr, onCompleted, &second));
+        dos_qqmlincubator_force_completion(incubator.get());
+        QVERIFY(second != nullptr);
+        QCOMPARE(second->objectName(), QString::fromLocal8Bit("testComponent"));
+        incubator.reset();
+        dos_qobject_delete(second);
+    }
+
+    void testPool()
+    {
+        VoidPointer component(dos_qqmlcomponent_create(m_engine, nullptr, nullptr), &dos_qqmlcomponent_delete);
+        VoidPointer url(dos_qurl_create("qrc:///testQQmlComponent.qml", QUrl::TolerantMode), &dos_qurl_delete);
+        dos_qqmlcomponent_load_url(component.get(), url.get(), false);
+
+        auto onRecycle = [](void *data, DosQObject *object) {
+            ++*static_cast<int *>(data);
+            static_cast<QObject *>(object)->setProperty("value", 42);
+        };
+        int recycled = 0;
+        VoidPointer pool(dos_qqmlcomponentpool_create(component.get(), nullptr, 2, onRecycle, &recycled), &dos_qqmlcomponentpool_delete);
+        dos_qqmlcomponentpool_fill(pool.get());
+        QTRY_COMPARE(dos_qqmlcomponentpool_available(pool.get()), 2);
+
+        auto first = static_cast<QObject *>(dos_qqmlcomponentpool_acquire(pool.get()));
+        QVERIFY(first != nullptr);
+        QVERIFY(first->parent() == nullptr);
+        QCOMPARE(dos_qqmlcomponentpool_available(pool.get()), 1);
+        first->setProperty("value", 7);
+        dos_qqmlcomponentpool_release(pool.get(), first);
+        QCOMPARE(recycled, 1);
+        QCOMPARE(dos_qqmlcomponentpool_available(pool.get()), 2);
+
+        auto reused = static_cast<QObject *>(dos_qqmlcomponentpool_acquire(pool.get()));
+        QCOMPARE(reused, first);
+        QCOMPARE(reused->property("value").toInt(), 42);
+
+        std::vector<DosQObject *> objects = { reused };
+        for (int i = 0; i < 2; ++i)
+            objects.push_back(dos_qqmlcomponentpool_acquire(pool.get()));
+        QCOMPARE(dos_qqmlcomponentpool_available(pool.get()), 0);
+        QVERIFY(objects.back() != nullptr);
+        for (DosQObject *object : objects)
+            dos_qqmlcomponentpool_release(pool.get(), object);
+        QCOMPARE(recycled, 3);
+        QCOMPARE(dos_qqmlcomponentpool_available(pool.get()), 2);
+
+        // Incubations completing after release() filled the pool don't exceed its capacity
+        objects = { dos_qqmlcomponentpool_acquire(pool.get()), dos_qqmlcomponentpool_acquire(pool.get()) };
+        dos_qqmlcomponentpool_fill(pool.get());
+        for (DosQObject *object : objects)
+            dos_qqmlcomponentpool_release(pool.get(), object);
+        QTest::qWait(200);
+        QCOMPARE(dos_qqmlcomponentpool_available(pool.get()), 2);
+    }
+
+private:
+    void *m_engine = nullptr;
+};
 
 /*
  * Test QObject
@@ -603,6 +776,537 @@ private slots:
         QVERIFY(result.toBool());
     }
 
+    void testFetchRange()
+    {
+        MockQAbstractItemModel mock(MockQAbstractItemModel::FetchRange | MockQAbstractItemModel::ListModel);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+
+        QCOMPARE(model->data(model->index(0, 0, QModelIndex())).toString(), QString("John"));
+        QCOMPARE(model->data(model->index(3, 0, QModelIndex())).toString(), QString("Anna"));
+        QCOMPARE(mock.fetchRangeCalls(), 1);
+        QCOMPARE(mock.dataCalls(), 0);
+
+        QVERIFY(model->setData(model->index(1, 0, QModelIndex()), QString("Paul")));
+        QCOMPARE(model->data(model->index(1, 0, QModelIndex())).toString(), QString("Paul"));
+        QCOMPARE(mock.fetchRangeCalls(), 2);
+        QCOMPARE(mock.dataCalls(), 0);
+
+        // Indexes of item models are created by the binding thus their rows aren't prefetched
+        MockQAbstractItemModel tree(MockQAbstractItemModel::FetchRange);
+        auto treeModel = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(tree.data()));
+        QCOMPARE(treeModel->data(treeModel->index(0, 0, QModelIndex())).toString(), QString("John"));
+        QCOMPARE(tree.fetchRangeCalls(), 0);
+        QCOMPARE(tree.dataCalls(), 1);
+    }
+
+    void testDataCache()
+    {
+        MockQAbstractItemModel mock;
+        dos_qabstractitemmodel_setDataCacheBudget(mock.data(), 1024 * 1024);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+
+        QCOMPARE(model->data(model->index(0, 0, QModelIndex())).toString(), QString("John"));
+        QCOMPARE(model->data(model->index(1, 0, QModelIndex())).toString(), QString("Mary"));
+        QCOMPARE(mock.dataCalls(), 2);
+        QCOMPARE(model->data(model->index(0, 0, QModelIndex())).toString(), QString("John"));
+        QCOMPARE(model->data(model->index(1, 0, QModelIndex())).toString(), QString("Mary"));
+        QCOMPARE(mock.dataCalls(), 2);
+
+        QVERIFY(model->setData(model->index(1, 0, QModelIndex()), QString("Paul")));
+        QCOMPARE(model->data(model->index(0, 0, QModelIndex())).toString(), QString("John"));
+        QCOMPARE(mock.dataCalls(), 2);
+        QCOMPARE(model->data(model->index(1, 0, QModelIndex())).toString(), QString("Paul"));
+        QCOMPARE(mock.dataCalls(), 3);
+    }
+
+    void benchmarkModelImplDynamicCast()
+    {
+        MockQAbstractItemModel mock;
+        auto object = static_cast<QObject *>(mock.data());
+        DOS::DosIQAbstractItemModelImpl *result = nullptr;
+        QBENCHMARK {
+            result = dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object);
+        }
+        QVERIFY(result);
+    }
+
+    void benchmarkModelImplInterfaceCast()
+    {
+        MockQAbstractItemModel mock;
+        auto object = static_cast<QObject *>(mock.data());
+        DOS::DosIQAbstractItemModelImpl *result = nullptr;
+        QBENCHMARK {
+            result = DOS::toModelImpl(object);
+        }
+        QCOMPARE(result, dynamic_cast<DOS::DosIQAbstractItemModelImpl *>(object));
+    }
+
+    void testAsyncFetchMore()
+    {
+        MockQAbstractItemModel mock(MockQAbstractItemModel::AsyncFetch);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+
+        mock.setFetchableNames(std::vector<std::string>(300, "Bob"));
+        QVERIFY(model->canFetchMore(QModelIndex()));
+        model->fetchMore(QModelIndex());
+        QVERIFY(!model->canFetchMore(QModelIndex()));
+
+        QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+        VoidPointer parent(dos_qmodelindex_create(), &dos_qmodelindex_delete);
+        std::unique_ptr<QThread> worker(QThread::create([&parent, &mock] {
+            dos_qabstractitemmodel_fetchComplete(mock.data(), parent.get(), 300);
+        }));
+        worker->start();
+        QVERIFY(worker->wait());
+        QCOMPARE(insertedSpy.count(), 0);
+
+        QTRY_COMPARE(insertedSpy.count(), 2);
+        QCOMPARE(model->rowCount(), 304);
+        QCOMPARE(model->data(model->index(303, 0, QModelIndex())).toString(), QString("Bob"));
+        QVERIFY(!model->canFetchMore(QModelIndex()));
+
+        // A completion without a matching fetchMore() is dropped
+        dos_qabstractitemmodel_fetchComplete(mock.data(), parent.get(), 10);
+        QCoreApplication::processEvents();
+        QCOMPARE(insertedSpy.count(), 2);
+        QCOMPARE(model->rowCount(), 304);
+    }
+
+    void testTreeNodeStore()
+    {
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(testObject->data()));
+        QVERIFY(model);
+        dos_qabstractitemmodel_enableTree(testObject->data(), 1);
+        QCOMPARE(model->rowCount(), 0);
+
+        QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+        VoidPointer root(dos_qmodelindex_create(), &dos_qmodelindex_delete);
+        const uintptr_t rootPayloads[] = { 1, 2 };
+        QVERIFY(dos_qabstractitemmodel_treeInsert(testObject->data(), root.get(), 0, rootPayloads, 2));
+        QVERIFY(!dos_qabstractitemmodel_treeInsert(testObject->data(), root.get(), 0, rootPayloads, 1));
+        VoidPointer first(dos_qabstractitemmodel_treeIndex(testObject->data(), 1, 0), &dos_qmodelindex_delete);
+        const uintptr_t childPayloads[] = { 10, 12 };
+        QVERIFY(dos_qabstractitemmodel_treeInsert(testObject->data(), first.get(), 0, childPayloads, 2));
+        const uintptr_t middlePayload[] = { 11 };
+        QVERIFY(dos_qabstractitemmodel_treeInsert(testObject->data(), first.get(), 1, middlePayload, 1));
+        QCOMPARE(insertedSpy.count(), 3);
+
+        const QModelIndex parent = model->index(0, 0);
+        QCOMPARE(model->rowCount(), 2);
+        QCOMPARE(model->rowCount(parent), 3);
+        QVERIFY(model->hasChildren(parent));
+        QVERIFY(!model->hasChildren(model->index(1, 0)));
+        const QModelIndex child = model->index(2, 0, parent);
+        QCOMPARE(child.internalId(), quintptr(12));
+        QCOMPARE(model->parent(child), parent);
+        VoidPointer last(dos_qabstractitemmodel_treeIndex(testObject->data(), 12, 0), &dos_qmodelindex_delete);
+        QCOMPARE(dos_qmodelindex_row(last.get()), 2);
+
+        QVERIFY(dos_qabstractitemmodel_treeRemove(testObject->data(), root.get(), 0, 1));
+        QCOMPARE(model->rowCount(), 1);
+        VoidPointer removed(dos_qabstractitemmodel_treeIndex(testObject->data(), 11, 0), &dos_qmodelindex_delete);
+        QVERIFY(!dos_qmodelindex_isValid(removed.get()));
+        QCOMPARE(model->index(0, 0).internalId(), quintptr(2));
+
+        dos_qabstractitemmodel_treeClear(testObject->data());
+        QCOMPARE(model->rowCount(), 0);
+    }
+
+    void testModelIndexValue()
+    {
+        MockQAbstractItemModel mock;
+
+        const DosModelIndexValue index = dos_qabstractitemmodel_createIndexValue(mock.data(), 1, 0, 0);
+        QVERIFY(dos_qmodelindex_value_isValid(index));
+        VoidPointer data(dos_qmodelindex_value_data(index, Qt::DisplayRole), &dos_qvariant_delete);
+        CharPointer name(dos_qvariant_toString(data.get()), &dos_chararray_delete);
+        QCOMPARE(QString(name.get()), QString("Mary"));
+
+        QVERIFY(!dos_qmodelindex_value_isValid(dos_qmodelindex_value_parent(index)));
+        const DosModelIndexValue sibling = dos_qmodelindex_value_sibling(index, 2, 0);
+        QVERIFY(dos_qmodelindex_value_isValid(sibling));
+        QCOMPARE(sibling.row, 2);
+
+        VoidPointer qmodelindex(dos_qmodelindex_create(), &dos_qmodelindex_delete);
+        dos_qmodelindex_assign_value(qmodelindex.get(), sibling);
+        QCOMPARE(dos_qmodelindex_row(qmodelindex.get()), 2);
+        const DosModelIndexValue value = dos_qmodelindex_to_value(qmodelindex.get());
+        QCOMPARE(value.row, 2);
+        QCOMPARE(value.column, 0);
+        QCOMPARE(value.model, mock.data());
+    }
+
+    void testValueCallbacks()
+    {
+        MockQAbstractItemModel mock;
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+
+        DosQAbstractItemModelValueCallbacks callbacks = {};
+        callbacks.size = sizeof(callbacks);
+        callbacks.rowCount = [](void *, DosModelIndexValue parent, int *result) {
+            *result = parent.model ? 0 : 42;
+        };
+        dos_qabstractitemmodel_setValueCallbacks(mock.data(), &callbacks);
+        QCOMPARE(model->rowCount(), 42);
+        QCOMPARE(model->columnCount(), 1);
+
+        // A struct smaller than the current one leaves the trailing callbacks unset
+        callbacks.size = offsetof(DosQAbstractItemModelValueCallbacks, rowCount);
+        dos_qabstractitemmodel_setValueCallbacks(mock.data(), &callbacks);
+        QCOMPARE(model->rowCount(), 4);
+    }
+
+    void testQueueDataChanged()
+    {
+        MockQAbstractItemModel mock;
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+
+        QSignalSpy dataChangedSpy(model, &QAbstractItemModel::dataChanged);
+        const int displayRole[] = { Qt::DisplayRole };
+        const int editRole[] = { Qt::EditRole };
+        dos_qabstractitemmodel_queueDataChanged(mock.data(), 2, 0, displayRole, 1);
+        dos_qabstractitemmodel_queueDataChanged(mock.data(), 0, 0, displayRole, 1);
+        dos_qabstractitemmodel_queueDataChanged(mock.data(), 1, 0, editRole, 1);
+        QCOMPARE(dataChangedSpy.count(), 0);
+        QTRY_COMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).value<QModelIndex>().row(), 0);
+        QCOMPARE(dataChangedSpy.at(0).at(1).value<QModelIndex>().row(), 2);
+        QCOMPARE(qvariant_cast<QVector<int>>(dataChangedSpy.at(0).at(2)), QVector<int>({Qt::DisplayRole, Qt::EditRole}));
+
+        dos_qabstractitemmodel_queueDataChanged(mock.data(), 3, 0, nullptr, 0);
+        dos_qabstractitemmodel_flushDataChanged(mock.data());
+        QCOMPARE(dataChangedSpy.count(), 2);
+        QVERIFY(qvariant_cast<QVector<int>>(dataChangedSpy.at(1).at(2)).isEmpty());
+    }
+
+    void testStaticData()
+    {
+        MockQAbstractItemModel mock;
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+
+        QCOMPARE(model->headerData(1, Qt::Horizontal).toInt(), 1);
+        QCOMPARE(model->headerData(1, Qt::Horizontal).toInt(), 1);
+        QCOMPARE(mock.headerDataCalls(), 2);
+
+        dos_qabstractitemmodel_setStaticData(mock.data(), DosStaticRoleNames | DosStaticFlags | DosStaticHeaderData);
+        QCOMPARE(model->headerData(1, Qt::Horizontal).toInt(), 1);
+        QCOMPARE(model->headerData(1, Qt::Horizontal).toInt(), 1);
+        QCOMPARE(model->headerData(1, Qt::Vertical).toInt(), 1);
+        QCOMPARE(mock.headerDataCalls(), 4);
+
+        QSignalSpy headerDataChangedSpy(model, &QAbstractItemModel::headerDataChanged);
+        dos_qabstractitemmodel_invalidateHeaderData(mock.data(), Qt::Horizontal, 0, 1);
+        QCOMPARE(headerDataChangedSpy.count(), 1);
+        QCOMPARE(model->headerData(1, Qt::Horizontal).toInt(), 1);
+        QCOMPARE(model->headerData(1, Qt::Vertical).toInt(), 1);
+        QCOMPARE(mock.headerDataCalls(), 5);
+    }
+
+    void testMoveRows()
+    {
+        MockQAbstractItemModel mock;
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+        QVERIFY(!model->moveRows(QModelIndex(), 0, 1, QModelIndex(), 4));
+
+        QSignalSpy movedSpy(model, &QAbstractItemModel::rowsMoved);
+        VoidPointer parent(dos_qmodelindex_create(), &dos_qmodelindex_delete);
+        QVERIFY(!dos_qabstractitemmodel_beginMoveRows(mock.data(), parent.get(), 0, 0, parent.get(), 1));
+        QVERIFY(dos_qabstractitemmodel_beginMoveRows(mock.data(), parent.get(), 0, 0, parent.get(), 4));
+        mock.setNames({"Mary", "Andy", "Anna", "John"});
+        dos_qabstractitemmodel_endMoveRows(mock.data());
+
+        QCOMPARE(movedSpy.count(), 1);
+        QCOMPARE(model->data(model->index(0, 0, QModelIndex())).toString(), QString("Mary"));
+        QCOMPARE(model->data(model->index(3, 0, QModelIndex())).toString(), QString("John"));
+    }
+
+    void testApplySnapshot()
+    {
+        MockQAbstractItemModel mock;
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mock.data()));
+        QVERIFY(model);
+
+        QSignalSpy resetSpy(model, &QAbstractItemModel::modelReset);
+        const unsigned long long keys[] = { 1, 2, 3, 4 };
+        const unsigned long long hashes[] = { 1, 1, 1, 1 };
+        dos_qabstractitemmodel_applySnapshot(mock.data(), keys, hashes, 4);
+        QCOMPARE(resetSpy.count(), 1);
+
+        // Remove Mary, move Anna to the top, rename Andy and append Paul
+        mock.setNames({"Anna", "John", "Andrew", "Paul"});
+        QSignalSpy removedSpy(model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy movedSpy(model, &QAbstractItemModel::rowsMoved);
+        QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy changedSpy(model, &QAbstractItemModel::dataChanged);
+        QString firstRowAfterMove;
+        connect(model, &QAbstractItemModel::rowsMoved, [&] {
+            firstRowAfterMove = model->data(model->index(0, 0, QModelIndex())).toString();
+        });
+
+        const unsigned long long newKeys[] = { 4, 1, 3, 5 };
+        const unsigned long long newHashes[] = { 1, 1, 2, 1 };
+        dos_qabstractitemmodel_applySnapshot(mock.data(), newKeys, newHashes, 4);
+
+        QCOMPARE(resetSpy.count(), 1);
+        QCOMPARE(removedSpy.count(), 1);
+        QCOMPARE(removedSpy.first().at(1).toInt(), 1);
+        QCOMPARE(movedSpy.count(), 1);
+        QCOMPARE(movedSpy.first().at(1).toInt(), 2);
+        QCOMPARE(movedSpy.first().at(4).toInt(), 0);
+        QCOMPARE(firstRowAfterMove, QString("Anna"));
+        QCOMPARE(insertedSpy.count(), 1);
+        QCOMPARE(insertedSpy.first().at(1).toInt(), 3);
+        QCOMPARE(changedSpy.count(), 1);
+        QCOMPARE(changedSpy.first().at(0).value<QModelIndex>().row(), 2);
+        QCOMPARE(model->rowCount(), 4);
+        QCOMPARE(model->data(model->index(2, 0, QModelIndex())).toString(), QString("Andrew"));
+    }
+
+    void testColumnarModel()
+    {
+        VoidPointer metaObject(dos_qabstractlistmodel_qmetaobject(), &dos_qmetaobject_delete);
+        const int roleTypes[] = { QMetaType::Int, QMetaType::QString };
+        const char *roleNames[] = { "id", "name" };
+        VoidPointer columnar(dos_qcolumnarmodel_create(nullptr, metaObject.get(), nullptr, 2, roleTypes, roleNames), &dos_qobject_delete);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(columnar.get()));
+        QVERIFY(model);
+        QCOMPARE(model->roleNames().value(Qt::UserRole + 2), QByteArray("name"));
+
+        const int ids[] = { 1, 2, 3 };
+        const char *names[] = { "John", "Mary", "Andy" };
+        const void *columns[] = { ids, names };
+        QVERIFY(dos_qcolumnarmodel_append(columnar.get(), 3, columns));
+        QCOMPARE(model->rowCount(), 3);
+        QCOMPARE(model->data(model->index(2, 0), Qt::UserRole + 1).toInt(), 3);
+        QCOMPARE(model->data(model->index(2, 0), Qt::UserRole + 2).toString(), QString("Andy"));
+
+        QSignalSpy dataChangedSpy(model, &QAbstractItemModel::dataChanged);
+        const char *newNames[] = { "Anna" };
+        const void *updatedColumns[] = { nullptr, newNames };
+        QVERIFY(dos_qcolumnarmodel_update_range(columnar.get(), 1, 1, updatedColumns));
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(model->data(model->index(1, 0), Qt::UserRole + 1).toInt(), 2);
+        QCOMPARE(model->data(model->index(1, 0), Qt::UserRole + 2).toString(), QString("Anna"));
+
+        QVERIFY(dos_qcolumnarmodel_remove_range(columnar.get(), 0, 2));
+        QCOMPARE(model->rowCount(), 1);
+        QCOMPARE(model->data(model->index(0, 0), Qt::UserRole + 2).toString(), QString("Andy"));
+        QVERIFY(!dos_qcolumnarmodel_remove_range(columnar.get(), 0, 2));
+    }
+
+    void testColumnarModelJournal()
+    {
+        VoidPointer metaObject(dos_qabstractlistmodel_qmetaobject(), &dos_qmetaobject_delete);
+        const int roleTypes[] = { QMetaType::Int, QMetaType::QString };
+        const char *roleNames[] = { "id", "name" };
+        VoidPointer columnar(dos_qcolumnarmodel_create(nullptr, metaObject.get(), nullptr, 2, roleTypes, roleNames), &dos_qobject_delete);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(columnar.get()));
+        QVERIFY(model);
+
+        QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy removedSpy(model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy changedSpy(model, &QAbstractItemModel::dataChanged);
+
+        // Adjacent insertions recorded from another thread are signaled once
+        std::unique_ptr<QThread> producer(QThread::create([&columnar] {
+            for (int i = 0; i < 4; ++i) {
+                const int ids[] = { 2 * i, 2 * i + 1 };
+                const void *columns[] = { ids, nullptr };
+                dos_qcolumnarmodel_journal_insert(columnar.get(), 2 * i, 2, columns);
+            }
+        }));
+        producer->start();
+        QVERIFY(producer->wait());
+        QTRY_COMPARE(model->rowCount(), 8);
+        QCOMPARE(insertedSpy.count(), 1);
+        QCOMPARE(insertedSpy.first().at(2).toInt(), 7);
+        QCOMPARE(model->data(model->index(5, 0), Qt::UserRole + 1).toInt(), 5);
+
+        // Overlapping updates are merged and structural changes flush them
+        const char *names[] = { "John", "Mary" };
+        const void *updatedColumns[] = { nullptr, names };
+        dos_qcolumnarmodel_journal_update(columnar.get(), 0, 2, updatedColumns);
+        dos_qcolumnarmodel_journal_update(columnar.get(), 1, 2, updatedColumns);
+        dos_qcolumnarmodel_journal_remove(columnar.get(), 6, 2);
+        dos_qcolumnarmodel_journal_remove(columnar.get(), 4, 2);
+        dos_qcolumnarmodel_journal_move(columnar.get(), 0, 1, 4);
+        dos_qcolumnarmodel_journal_remove(columnar.get(), 10, 1);
+        dos_qcolumnarmodel_journal_replay(columnar.get());
+        QCOMPARE(changedSpy.count(), 1);
+        QCOMPARE(changedSpy.first().at(1).value<QModelIndex>().row(), 2);
+        QCOMPARE(removedSpy.count(), 1);
+        QCOMPARE(model->rowCount(), 4);
+        QCOMPARE(model->data(model->index(0, 0), Qt::UserRole + 2).toString(), QString("John"));
+        QCOMPARE(model->data(model->index(3, 0), Qt::UserRole + 1).toInt(), 0);
+        QCOMPARE(model->data(model->index(3, 0), Qt::UserRole + 2).toString(), QString("John"));
+    }
+
+    void testRingBufferModel()
+    {
+        VoidPointer metaObject(dos_qabstractlistmodel_qmetaobject(), &dos_qmetaobject_delete);
+        const int roleTypes[] = { QMetaType::Int, QMetaType::QString };
+        const char *roleNames[] = { "id", "line" };
+        VoidPointer ring(dos_qringbuffermodel_create(nullptr, metaObject.get(), nullptr, 8, 2, roleTypes, roleNames), &dos_qobject_delete);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(ring.get()));
+        QVERIFY(model);
+
+        QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy removedSpy(model, &QAbstractItemModel::rowsRemoved);
+        const int ids[] = { 1, 2, 3 };
+        const char *lines[] = { "a", "b", "c" };
+        const void *columns[] = { ids, lines };
+        std::unique_ptr<QThread> worker(QThread::create([&ring, &columns] {
+            dos_qringbuffermodel_append(ring.get(), 3, columns);
+            dos_qringbuffermodel_append(ring.get(), 3, columns);
+        }));
+        worker->start();
+        QVERIFY(worker->wait());
+        QCOMPARE(model->rowCount(), 0);
+
+        QTRY_COMPARE(insertedSpy.count(), 1);
+        QCOMPARE(removedSpy.count(), 0);
+        QCOMPARE(model->rowCount(), 6);
+        QCOMPARE(model->data(model->index(0, 0), Qt::UserRole + 1).toInt(), 1);
+        QCOMPARE(model->data(model->index(5, 0), Qt::UserRole + 2).toString(), QString("c"));
+
+        const int newIds[] = { 4, 5, 6 };
+        const void *newColumns[] = { newIds, nullptr };
+        dos_qringbuffermodel_append(ring.get(), 3, newColumns);
+        dos_qringbuffermodel_flush(ring.get());
+        QCOMPARE(removedSpy.count(), 1);
+        QCOMPARE(insertedSpy.count(), 2);
+        QCOMPARE(model->rowCount(), 8);
+        QCOMPARE(model->data(model->index(0, 0), Qt::UserRole + 1).toInt(), 2);
+        QCOMPARE(model->data(model->index(7, 0), Qt::UserRole + 1).toInt(), 6);
+        QCOMPARE(model->data(model->index(7, 0), Qt::UserRole + 2).toString(), QString());
+
+        dos_qringbuffermodel_clear(ring.get());
+        QCOMPARE(model->rowCount(), 0);
+    }
+
+    void testMappedFileModel()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        const QString path = directory.filePath("records.bin");
+        auto record = [](char id, const char *name) {
+            QByteArray result(8, '\0');
+            result[0] = id;
+            result.replace(4, static_cast<int>(qstrlen(name)), name);
+            return result;
+        };
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(record(1, "John") + record(2, "Mary"));
+        file.flush();
+
+        VoidPointer metaObject(dos_qabstractlistmodel_qmetaobject(), &dos_qmetaobject_delete);
+        const DosMappedFieldDefinition fields[] = {
+            { "id", DosMappedFieldInt32, 0, 0 },
+            { "name", DosMappedFieldUtf8, 4, 4 }
+        };
+        const QByteArray dataPath = path.toUtf8();
+        VoidPointer mapped(dos_qmappedfilemodel_create(nullptr, metaObject.get(), nullptr, dataPath.constData(),
+                                                       nullptr, 0, 8, 2, fields), &dos_qobject_delete);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(mapped.get()));
+        QVERIFY(model);
+        QCOMPARE(model->rowCount(), 2);
+        QCOMPARE(model->data(model->index(1, 0), Qt::UserRole + 1).toInt(), 2);
+        QCOMPARE(model->data(model->index(1, 0), Qt::UserRole + 2).toString(), QString("Mary"));
+
+        QSignalSpy insertedSpy(model, &QAbstractItemModel::rowsInserted);
+        file.write(record(3, "Ann"));
+        file.flush();
+        QVERIFY(dos_qmappedfilemodel_refresh(mapped.get()));
+        QCOMPARE(insertedSpy.count(), 1);
+        QCOMPARE(model->rowCount(), 3);
+        QCOMPARE(model->data(model->index(2, 0), Qt::UserRole + 2).toString(), QString("Ann"));
+
+        QVERIFY(!dos_qmappedfilemodel_create(nullptr, metaObject.get(), nullptr, "missing.bin", nullptr, 0, 8, 2, fields));
+
+        // Offsets outside the data file are never dereferenced
+        const QString indexPath = directory.filePath("records.idx");
+        QFile index(indexPath);
+        QVERIFY(index.open(QIODevice::WriteOnly));
+        const quint64 offsets[] = { 0, quint64(1) << 63, 16 };
+        for (quint64 offset : offsets) {
+            uchar bytes[sizeof(quint64)];
+            qToLittleEndian(offset, bytes);
+            index.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+        }
+        index.flush();
+        const QByteArray indexPathData = indexPath.toUtf8();
+        VoidPointer indexed(dos_qmappedfilemodel_create(nullptr, metaObject.get(), nullptr, dataPath.constData(),
+                                                        indexPathData.constData(), 0, 0, 2, fields), &dos_qobject_delete);
+        auto indexedModel = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(indexed.get()));
+        QVERIFY(indexedModel);
+        QCOMPARE(indexedModel->rowCount(), 3);
+        QCOMPARE(indexedModel->data(indexedModel->index(0, 0), Qt::UserRole + 2).toString(), QString("John"));
+        QVERIFY(!indexedModel->data(indexedModel->index(1, 0), Qt::UserRole + 1).isValid());
+        QCOMPARE(indexedModel->data(indexedModel->index(2, 0), Qt::UserRole + 2).toString(), QString("Ann"));
+    }
+
+    void testSortFilterProxyModel()
+    {
+        VoidPointer metaObject(dos_qabstractlistmodel_qmetaobject(), &dos_qmetaobject_delete);
+        const int roleTypes[] = { QMetaType::Int, QMetaType::QString };
+        const char *roleNames[] = { "id", "name" };
+        VoidPointer columnar(dos_qcolumnarmodel_create(nullptr, metaObject.get(), nullptr, 2, roleTypes, roleNames), &dos_qobject_delete);
+        const int ids[] = { 3, 1, 2, 5, 4 };
+        const char *names[] = { "Mary", "Andy", "Anna", "John", "Marc" };
+        const void *columns[] = { ids, names };
+        QVERIFY(dos_qcolumnarmodel_append(columnar.get(), 5, columns));
+
+        VoidPointer proxy(dos_qsortfilterproxymodel_create(), &dos_qobject_delete);
+        auto model = qobject_cast<QAbstractItemModel *>(static_cast<QObject *>(proxy.get()));
+        QVERIFY(model);
+        dos_qsortfilterproxymodel_setSourceModel(proxy.get(), columnar.get());
+        dos_qsortfilterproxymodel_setSortRole(proxy.get(), Qt::UserRole + 1);
+        dos_qsortfilterproxymodel_sort(proxy.get(), 0, Qt::AscendingOrder);
+        QCOMPARE(model->rowCount(), 5);
+        QCOMPARE(model->data(model->index(0, 0), Qt::UserRole + 2).toString(), QString("Andy"));
+        QCOMPARE(model->data(model->index(4, 0), Qt::UserRole + 2).toString(), QString("John"));
+
+        dos_qsortfilterproxymodel_setFilterRole(proxy.get(), Qt::UserRole + 2);
+        dos_qsortfilterproxymodel_setFilterCaseSensitive(proxy.get(), false);
+        dos_qsortfilterproxymodel_setFilterFixedString(proxy.get(), "a");
+        QCOMPARE(model->rowCount(), 4);
+        dos_qsortfilterproxymodel_setFilterFixedString(proxy.get(), "an");
+        QCOMPARE(model->rowCount(), 2);
+        QCOMPARE(model->data(model->index(1, 0), Qt::UserRole + 2).toString(), QString("Anna"));
+
+        // Role changes through the base class keep applying the filter string
+        auto base = qobject_cast<QSortFilterProxyModel *>(model);
+        QVERIFY(base);
+        base->setFilterRole(Qt::UserRole + 1);
+        QCOMPARE(model->rowCount(), 0);
+        QCoreApplication::processEvents();
+        base->setFilterRole(Qt::UserRole + 2);
+        QCOMPARE(model->rowCount(), 2);
+        QCoreApplication::processEvents();
+
+        const int newIds[] = { 0 };
+        const char *newNames[] = { "Dan" };
+        const void *newColumns[] = { newIds, newNames };
+        QVERIFY(dos_qcolumnarmodel_append(columnar.get(), 1, newColumns));
+        QCOMPARE(model->rowCount(), 3);
+        QCOMPARE(model->data(model->index(0, 0), Qt::UserRole + 2).toString(), QString("Dan"));
+
+        const QModelIndex proxyIndex = model->index(0, 0);
+        VoidPointer sourceIndex(dos_qsortfilterproxymodel_mapToSource(proxy.get(), &proxyIndex), &dos_qmodelindex_delete);
+        QCOMPARE(dos_qmodelindex_row(sourceIndex.get()), 5);
+
+        dos_qsortfilterproxymodel_setFilterFixedString(proxy.get(), nullptr);
+        QCOMPARE(model->rowCount(), 6);
+    }
+
 
 private:
     QString value;
@@ -664,6 +1368,95 @@ private slots:
         QVERIFY(result.toBool());
     }
 
+    void testQmlRegisterManyTypes()
+    {
+        // More types than the former limit of 36 registrations for each wrapper class
+        for (int i = 0; i < 40; ++i) {
+            const std::string name = "MockQObject" + std::to_string(i);
+            ::QmlRegisterType registerType;
+            registerType.major = 1;
+            registerType.minor = 0;
+            registerType.uri = "MockManyModule";
+            registerType.qml = name.c_str();
+            registerType.staticMetaObject = MockQObject::staticMetaObject();
+            registerType.createDObject = &mockQObjectCreator;
+            registerType.deleteDObject = &mockQObjectDeleter;
+            QVERIFY(dos_qdeclarative_qmlregistertype(&registerType) != -1);
+        }
+
+        QQmlEngine engine;
+        QQmlComponent component(&engine);
+        component.setData("import MockManyModule 1.0\nMockQObject39 { name: \"foo\" }", QUrl());
+        std::unique_ptr<QObject> object(component.create());
+        QVERIFY(object);
+        QCOMPARE(object->property("name").toString(), QString("foo"));
+    }
+
+    void testQmlRegisterTypeMetaType()
+    {
+        ::QmlRegisterType registerType;
+        registerType.major = 1;
+        registerType.minor = 0;
+        registerType.uri = "MockMetaTypeModule";
+        registerType.qml = "MockQObject";
+        registerType.staticMetaObject = MockQObject::staticMetaObject();
+        registerType.createDObject = &mockQObjectCreator;
+        registerType.deleteDObject = &mockQObjectDeleter;
+        QVERIFY(dos_qdeclarative_qmlregistertype(&registerType) != -1);
+
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+#if (QT_VERSION < QT_VERSION_CHECK(6, 9, 0))
+        const QMetaType metaType = QMetaType::fromName("MockQObject*");
+        QVERIFY(metaType.isValid());
+        QCOMPARE(QByteArray(metaType.name()), QByteArray("MockQObject*"));
+        QCOMPARE(metaType.sizeOf(), qsizetype(sizeof(void *)));
+        QVERIFY(metaType.flags() & QMetaType::PointerToQObject);
+        QCOMPARE(QString(metaType.metaObject()->className()), QString("MockQObject"));
+#endif
+#else
+        const int id = QMetaType::type("MockQObject*");
+        QVERIFY(id != QMetaType::UnknownType);
+        QCOMPARE(QByteArray(QMetaType::typeName(id)), QByteArray("MockQObject*"));
+        QCOMPARE(QMetaType::sizeOf(id), int(sizeof(void *)));
+        QVERIFY(QMetaType::typeFlags(id) & QMetaType::PointerToQObject);
+#endif
+    }
+
+    void testQmlRegisterSingletonModes()
+    {
+        ::QmlRegisterType registerType;
+        registerType.major = 1;
+        registerType.minor = 0;
+        registerType.uri = "MockSingletonModule";
+        registerType.qml = "MockQObjectEager";
+        registerType.staticMetaObject = MockQObject::staticMetaObject();
+        registerType.createDObject = &countingMockQObjectCreator;
+        registerType.deleteDObject = &mockQObjectDeleter;
+
+        const int created = createdCount;
+        QVERIFY(dos_qdeclarative_qmlregistersingletontype_with_mode(&registerType, DosQmlSingletonModeEager, &prepareSingleton) != -1);
+        QCOMPARE(createdCount, created + 1);
+        QCOMPARE(preparedCount.load(), 1);
+
+        registerType.qml = "MockQObjectPreloaded";
+        QVERIFY(dos_qdeclarative_qmlregistersingletontype_with_mode(&registerType, DosQmlSingletonModePreloaded, &prepareSingleton) != -1);
+        QCOMPARE(createdCount, created + 1);
+
+        registerType.qml = "MockQObjectInvalid";
+        QCOMPARE(dos_qdeclarative_qmlregistersingletontype_with_mode(&registerType, DosQmlSingletonModePreloaded + 1, &prepareSingleton), -1);
+        QCOMPARE(createdCount, created + 1);
+
+        QQmlEngine engine;
+        QQmlComponent component(&engine);
+        component.setData("import QtQml 2.12\nimport MockSingletonModule 1.0\n"
+                          "QtObject { property string eager: MockQObjectEager.name; property string preloaded: MockQObjectPreloaded.name }", QUrl());
+        std::unique_ptr<QObject> object(component.create());
+        QVERIFY(object);
+        QCOMPARE(createdCount, created + 2);
+        QCOMPARE(preparedCount.load(), 2);
+        QCOMPARE(preparedOffThreadCount.load(), 1);
+    }
+
 private:
     static void mockQObjectCreator(int /*typeId*/, void *wrapper, void **mockQObjectPtr, void **dosQObject)
     {
@@ -681,8 +1474,29 @@ private:
     }
 
     static void emptyVoidDeleter(void *) {}
+
+    static void countingMockQObjectCreator(int typeId, void *wrapper, void **mockQObjectPtr, void **dosQObject)
+    {
+        ++createdCount;
+        mockQObjectCreator(typeId, wrapper, mockQObjectPtr, dosQObject);
+    }
+
+    static void prepareSingleton(int /*typeId*/)
+    {
+        ++preparedCount;
+        if (QThread::currentThread() != qApp->thread())
+            ++preparedOffThreadCount;
+    }
+
+    static int createdCount;
+    static std::atomic<int> preparedCount;
+    static std::atomic<int> preparedOffThreadCount;
 };
 
+int TestQDeclarativeIntegration::createdCount = 0;
+std::atomic<int> TestQDeclarativeIntegration::preparedCount(0);
+std::atomic<int> TestQDeclarativeIntegration::preparedOffThreadCount(0);
+
 
 /*
  * Test QModelIndex
@@ -800,6 +1614,134 @@ private slots:
         called = false;
     }
 
+    void testCreateCache() {
+        VoidPointer superClass(dos_qobject_qmetaobject(), &dos_qmetaobject_delete);
+        ParameterDefinition parameters[1];
+        parameters[0].name = "value";
+        parameters[0].metaType = QMetaType::Int;
+        ::SignalDefinition signalDefinitionArray[1];
+        signalDefinitionArray[0].name = "valueChanged";
+        signalDefinitionArray[0].parametersCount = 1;
+        signalDefinitionArray[0].parameters = parameters;
+        ::SignalDefinitions signalDefinitions = { 1, signalDefinitionArray };
+        ::SlotDefinitions slotDefinitions = { 0, nullptr };
+        ::PropertyDefinitions propertyDefinitions = { 0, nullptr };
+
+        int hits = 0;
+        int misses = 0;
+        dos_qmetaobject_cache_statistics(&hits, &misses);
+
+        auto metaObject = [](void *vptr) {
+            return static_cast<DOS::DosIQMetaObjectHolder *>(vptr)->data()->metaObject();
+        };
+        VoidPointer first(dos_qmetaobject_create(superClass.get(), "CachedObject", &signalDefinitions, &slotDefinitions, &propertyDefinitions), &dos_qmetaobject_delete);
+        VoidPointer second(dos_qmetaobject_create(superClass.get(), "CachedObject", &signalDefinitions, &slotDefinitions, &propertyDefinitions), &dos_qmetaobject_delete);
+        parameters[0].metaType = QMetaType::QString;
+        VoidPointer third(dos_qmetaobject_create(superClass.get(), "CachedObject", &signalDefinitions, &slotDefinitions, &propertyDefinitions), &dos_qmetaobject_delete);
+        QCOMPARE(metaObject(first.get()), metaObject(second.get()));
+        QVERIFY(metaObject(first.get()) != metaObject(third.get()));
+
+        int newHits = 0;
+        int newMisses = 0;
+        dos_qmetaobject_cache_statistics(&newHits, &newMisses);
+        QCOMPARE(newHits - hits, 1);
+        QCOMPARE(newMisses - misses, 2);
+    }
+
+    void testCreateBatch() {
+        VoidPointer superClass(dos_qobject_qmetaobject(), &dos_qmetaobject_delete);
+        ParameterDefinition parameters[1];
+        parameters[0].name = "value";
+        parameters[0].metaType = QMetaType::Int;
+        ::SignalDefinition signalDefinitionArray[1];
+        signalDefinitionArray[0].name = "valueChanged";
+        signalDefinitionArray[0].parametersCount = 1;
+        signalDefinitionArray[0].parameters = parameters;
+
+        const int count = 64;
+        std::vector<QByteArray> classNames;
+        std::vector<DosQMetaObjectDescriptor> descriptors(count);
+        for (int i = 0; i < count; ++i)
+            classNames.push_back("BatchObject" + QByteArray::number(i));
+        for (int i = 0; i < count; ++i) {
+            DosQMetaObjectDescriptor &descriptor = descriptors[static_cast<size_t>(i)];
+            descriptor.superClassMetaObject = superClass.get();
+            descriptor.superClassIndex = i % 2 ? i - 1 : -1;
+            descriptor.className = classNames[static_cast<size_t>(i)].constData();
+            descriptor.signalDefinitions = { 1, signalDefinitionArray };
+            descriptor.slotDefinitions = { 0, nullptr };
+            descriptor.propertyDefinitions = { 0, nullptr };
+        }
+
+        std::vector<DosQMetaObject *> result(count, nullptr);
+        QVERIFY(dos_qmetaobject_create_batch(count, descriptors.data(), result.data()));
+        std::vector<VoidPointer> metaObjects;
+        for (DosQMetaObject *metaObject : result)
+            metaObjects.emplace_back(metaObject, &dos_qmetaobject_delete);
+
+        auto metaObject = [](void *vptr) {
+            return static_cast<DOS::DosIQMetaObjectHolder *>(vptr)->data()->metaObject();
+        };
+        for (int i = 0; i < count; ++i) {
+            const QMetaObject *created = metaObject(result[static_cast<size_t>(i)]);
+            QCOMPARE(QByteArray(created->className()), classNames[static_cast<size_t>(i)]);
+            QVERIFY(created->indexOfSignal("valueChanged(int)") != -1);
+            const QMetaObject *expectedSuperClass = i % 2 ? metaObject(result[static_cast<size_t>(i - 1)]) : metaObject(superClass.get());
+            QCOMPARE(created->superClass(), expectedSuperClass);
+        }
+
+        // Batches share the cache of dos_qmetaobject_create()
+        ::SignalDefinitions signalDefinitions = { 1, signalDefinitionArray };
+        ::SlotDefinitions slotDefinitions = { 0, nullptr };
+        ::PropertyDefinitions propertyDefinitions = { 0, nullptr };
+        VoidPointer single(dos_qmetaobject_create(superClass.get(), "BatchObject0", &signalDefinitions, &slotDefinitions, &propertyDefinitions), &dos_qmetaobject_delete);
+        QCOMPARE(metaObject(single.get()), metaObject(result[0]));
+
+        descriptors[0].superClassIndex = 1;
+        QVERIFY(!dos_qmetaobject_create_batch(count, descriptors.data(), result.data()));
+    }
+
+    void testSerialize() {
+        ::SignalDefinitions signalDefinitions = { 0, nullptr };
+        ::SlotDefinitions slotDefinitions = { 0, nullptr };
+        ::PropertyDefinitions propertyDefinitions = { 0, nullptr };
+        VoidPointer subClass(dos_qmetaobject_create(MockQObject::staticMetaObject(), "MockQObjectSubClass", &signalDefinitions, &slotDefinitions, &propertyDefinitions), &dos_qmetaobject_delete);
+
+        DosQMetaObject *metaObjects[] = { MockQObject::staticMetaObject(), subClass.get() };
+        int size = 0;
+        CharPointer table(dos_qmetaobject_serialize(metaObjects, 2, &size), &dos_chararray_delete);
+        QVERIFY(table);
+        QVERIFY(!dos_qmetaobject_serialize(metaObjects + 1, 1, &size));
+        QVERIFY(!dos_qmetaobject_serialize(metaObjects, 2, nullptr));
+
+        DosQMetaObject *loaded[2] = {};
+        QVERIFY(!dos_qmetaobject_create_many(table.get(), size - 1, 2, loaded));
+        QVERIFY(!dos_qmetaobject_create_many(table.get(), size, 3, loaded));
+        QVERIFY(!dos_qmetaobject_create_many(table.get(), size, -1, loaded));
+        QVERIFY(!loaded[0] && !loaded[1]);
+        QVERIFY(dos_qmetaobject_create_many(table.get(), size, 2, loaded));
+        VoidPointer loadedClass(loaded[0], &dos_qmetaobject_delete);
+        VoidPointer loadedSubClass(loaded[1], &dos_qmetaobject_delete);
+
+        auto metaObject = [](void *vptr) {
+            return static_cast<DOS::DosIQMetaObjectHolder *>(vptr)->data()->metaObject();
+        };
+        const QMetaObject *original = metaObject(MockQObject::staticMetaObject());
+        const QMetaObject *copy = metaObject(loadedClass.get());
+        QCOMPARE(QByteArray(copy->className()), QByteArray(original->className()));
+        QCOMPARE(copy->methodCount(), original->methodCount());
+        QCOMPARE(copy->propertyCount(), original->propertyCount());
+        const QMetaMethod setName = copy->method(copy->indexOfSlot("setName(QString)"));
+        QCOMPARE(setName.methodSignature(), QByteArray("setName(QString)"));
+        const QMetaProperty name = copy->property(copy->indexOfProperty("name"));
+        QCOMPARE(name.notifySignal().methodSignature(), QByteArray("nameChanged(QString)"));
+        QCOMPARE(metaObject(loadedSubClass.get())->superClass(), copy);
+
+        auto holder = static_cast<DOS::DosIQMetaObjectHolder *>(loadedClass.get());
+        QCOMPARE(holder->data()->writeSlot("name").methodSignature(), QByteArray("setName(QString)"));
+        QCOMPARE(holder->data()->signal("nameChanged").methodSignature(), QByteArray("nameChanged(QString)"));
+    }
+
 private:
     static bool called;
     static void callback(void* /*data*/) {
@@ -837,6 +1779,7 @@ int main(int argc, char *argv[])
     success &= ExecuteTest<TestQModelIndex>(argc, argv);
     success &= ExecuteGuiTest<TestQQmlApplicationEngine>(argc, argv);
     success &= ExecuteGuiTest<TestQQmlContext>(argc, argv);
+    success &= ExecuteGuiTest<TestQQmlComponent>(argc, argv);
     success &= ExecuteGuiTest<TestQObject>(argc, argv);
     success &= ExecuteGuiTest<TestQAbstractItemModel>(argc, argv);
     success &= ExecuteGuiTest<TestQDeclarativeIntegration>(argc, argv);